@@ -12,7 +12,8 @@
 *  default constructor
 */
 	
-Application::Application()
+template< class Item >
+Application< Item >::Application()
 {
 	minsup=0;
 	remap=0;
@@ -22,6 +23,7 @@ Application::Application()
 	trie = 0;
 	bdN = 0;
 	bdP = 0;
+	tatree = 0;
 }
 
 // ----------------------------------------------------------------------------------------------
@@ -30,12 +32,12 @@ Application::Application()
 *  default destructor
 */
 
-Application::~Application()
+template< class Item >
+Application< Item >::~Application()
 {
 
 	if(trie) 
     {
-	    trie->deleteChildren();
 		delete trie;
 		trie = 0 ;
 	}
@@ -45,13 +47,11 @@ Application::~Application()
 	if(relist) delete relist;
 
 	if(bdN) {
-		bdN->deleteChildren();
 		delete bdN;
 		bdN = 0 ;
 	}
 
 	if(bdP) {
-		bdP->deleteChildren();
 		delete bdP;
 		bdP = 0 ;
 	}
@@ -69,24 +69,26 @@ Application::~Application()
 *   set of itemset and not only trie
 */
 
-int Application::countCandidates(Trie * tr,TATREE *tat, int min )
+template< class Item >
+int Application< Item >::countCandidates(Trie< Item > * tr,TATREE *tat, int min )
 {
-	if( tr == 0 || tat == 0 ) return 0 ;
+	if( tr == 0 || tat == 0 || tr->getChildren() == 0 ) return 0 ;
 
 	int used = 0 ;
 
-	set<Trie> * child = tr->getChildren() ;
+	set< Trie< Item > > * child = tr->getChildren() ;
 
-	for( set<Trie>::iterator itChild = child->begin(); itChild != child->end();itChild++ )
+	for( typename set< Trie< Item > >::iterator itChild = child->begin(); itChild != child->end();itChild++ )
 	{
-	    Trie * tmpT = const_cast< Trie * >( &(*itChild) ) ;
+	    Trie< Item > * tmpT = const_cast< Trie< Item > * >( &(*itChild) ) ;
 		used += count( tmpT, tat, min ) ;
 	}
 	return used ;
 
 }
 
-int Application::count( Trie * tr, TATREE *tat, int min )
+template< class Item >
+int Application< Item >::count( Trie< Item > * tr, TATREE *tat, int min )
 {
 
   if(tr == 0 || tat == 0 ) return 0;
@@ -121,11 +123,11 @@ int Application::count( Trie * tr, TATREE *tat, int min )
 		}
 		else
 		{
-			set<Trie> * child = tr->getChildren() ;
+			set< Trie< Item > > * child = tr->getChildren() ;
 
-			for( set<Trie>::iterator itChild = child->begin(); itChild != child->end();itChild++ )
+			for( typename set< Trie< Item > >::iterator itChild = child->begin(); itChild != child->end();itChild++ )
 			{
-			    Trie * tmpT = const_cast< Trie * >( &(*itChild) ) ;
+			    Trie< Item > * tmpT = const_cast< Trie< Item > * >( &(*itChild) ) ;
 				used += count(  tmpT, tat_child( tat, l ), min -1 );
 
 			}
@@ -149,7 +151,8 @@ int Application::count( Trie * tr, TATREE *tat, int min )
   return used;
 }
 
-int Application::countLeaf( int *t, int size, int cnt, Trie * tr, int spos)
+template< class Item >
+int Application< Item >::countLeaf( int *t, int size, int cnt, Trie< Item > * tr, int spos)
 {
   if(tr == 0) return 0;
   int used=0 ;
@@ -167,12 +170,12 @@ int Application::countLeaf( int *t, int size, int cnt, Trie * tr, int spos)
       }
       else 
 	  {
-		  set< Trie > * child = tr->getChildren() ;
+		  set< Trie< Item > > * child = tr->getChildren() ;
 
-		  for(set<Trie>::iterator it = child->begin(); spos<size  && it!=child->end() && t[spos]<=it->getId() ; it++) 
+		  for(typename set< Trie< Item > >::iterator it = child->begin(); spos<size  && it!=child->end() && t[spos]<=it->getId() ; it++) 
 		  {			
 			
-            Trie * tmpT = const_cast< Trie * >( &(*it) ) ;
+            Trie< Item > * tmpT = const_cast< Trie< Item > * >( &(*it) ) ;
 			used += countLeaf(t, size,cnt,  tmpT, spos+1);
 		  }
 	  }
@@ -180,3 +183,11 @@ int Application::countLeaf( int *t, int size, int cnt, Trie * tr, int spos)
   
   return used;
 }
+
+// ----------------------------------------------------------------------------------------------
+
+// instantiation for the item identifiers on 8, 16 and 32 bits
+
+template class Application< unsigned char > ;
+template class Application< short unsigned > ;
+template class Application< unsigned int > ;
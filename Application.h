@@ -29,6 +29,7 @@ public:
 };
 
 
+template< class Item >
 class Application
 {
 protected :
@@ -42,7 +43,7 @@ protected :
 	// represent a set of itemset
 	// ---------------------------
 
-	Trie * trie;
+	Trie< Item > * trie;
 
 	// ------------------------
 	// minsup of the algorithm
@@ -76,7 +77,7 @@ protected :
 	// into the item real name (the data of the table )
 	// -------------------------------------------------
 
-	short unsigned * remap;
+	int * remap;
 
 	// --------------------------------------
 	// set of element containing explicitely
@@ -98,13 +99,13 @@ protected :
 	// set of itemset representing de negative border
 	// -----------------------------------------------
 
-	Trie * bdN ;
+	Trie< Item > * bdN ;
 
 	// -----------------------------------------------
 	// set of itemset representing de positive border
 	// -----------------------------------------------
 
-	Trie * bdP ;
+	Trie< Item > * bdP ;
 
 
 
@@ -161,7 +162,7 @@ public:
 	// method initialising trie
 	// -------------------------------
 
-	void setTrie(  Trie * inTrie ){ trie = inTrie; } 
+	void setTrie(  Trie< Item > * inTrie ){ trie = inTrie; } 
 
 	// -------------------------------
 	// method initialising relist
@@ -173,7 +174,14 @@ public:
 	// method initialising remap
 	// -------------------------------
 
-	void setRemap(  short unsigned * inMap ){ remap = inMap; } 
+	void setRemap(  int * inMap ){ remap = inMap; } 
+
+	// -------------------------------------------
+	// method initialising the transaction tree
+	// ( 0 if it is shared and must not be deleted )
+	// -------------------------------------------
+
+	void setTatree( TATREE * inTree ){ tatree = inTree; } 
 
 	// --------------------------------------
 	// method returning the actual level
@@ -191,37 +199,43 @@ public:
 	// method returning the frequent itemsets
 	// ---------------------------------------	
 
-	Trie * getTrie() { return trie ; } 
+	Trie< Item > * getTrie() { return trie ; } 
 
 	// -------------------------------------
 	// method returning the negative border
 	// -------------------------------------
 
-	Trie * getBdN() { return bdN ; } 
+	Trie< Item > * getBdN() { return bdN ; } 
 	
 	// ----------------------------------------
 	// method initialising the negative border
 	// ----------------------------------------
 
-	void setBdN( Trie * inBdN ) { bdN = inBdN ; } 
+	void setBdN( Trie< Item > * inBdN ) { bdN = inBdN ; } 
 
 	// -------------------------------------
 	// method returning the positive border
 	// -------------------------------------
 
-	Trie * getBdP() { return bdP ; } 
+	Trie< Item > * getBdP() { return bdP ; } 
 
 	// ----------------------------------------
 	// method initialising the positive border
 	// ----------------------------------------
 
-	void setBdP( Trie * inBdP ) { bdP = inBdP ; } 
+	void setBdP( Trie< Item > * inBdP ) { bdP = inBdP ; } 
 
 	// -----------------------------------
 	// method returning the mapping table
 	// -----------------------------------
 
-	short unsigned * getRemap(){ return remap ; } 
+	int * getRemap(){ return remap ; } 
+
+	// --------------------------------------
+	// method returning the transaction tree
+	// --------------------------------------
+
+	TATREE * getTatree(){ return tatree ; } 
 		
 	// ----------------------------------------------------------
 	// this method update the support for the set of itemsets tr
@@ -229,11 +243,11 @@ public:
 	// only the transaction of size >= min are considered
 	// ----------------------------------------------------------
 
-	int countCandidates(Trie * tr,TATREE *tat, int min =0 );
+	int countCandidates(Trie< Item > * tr,TATREE *tat, int min =0 );
 
-	int count(Trie * tr ,TATREE *tat, int min =0 );
+	int count(Trie< Item > * tr ,TATREE *tat, int min =0 );
 
-	int countLeaf( int *t, int size, int cnt, Trie * tr, int spos = 0) ;
+	int countLeaf( int *t, int size, int cnt, Trie< Item > * tr, int spos = 0) ;
 	
 };
 
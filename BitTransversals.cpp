@@ -0,0 +1,289 @@
+/*----------------------------------------------------------------------
+  File    : BitTransversals.cpp
+  Contents: Class that calcul the minimal transversals of an hypergraph
+            with the incremental approach of Demetrovics et Thi when
+            the items fit in a few machine words : the transversals
+            and the edges are stored as bit vectors of W words so the
+            intersection and inclusion tests are done word by word
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "BitTransversals.h"
+#include "TrieIterator.h"
+
+/**
+*  method that store the itemsets of a trie in bit vectors
+*/
+
+template< class Item, int W >
+void BitTransversals< Item, W >::fromTrie( Trie< Item > * trie, vector< uint64_t > * bits )
+{
+	TrieIterator< Item > it( trie ) ;
+
+	vector< Item > * vect ;
+
+	size_t pos ;
+
+	while( it.next() )
+	{
+		vect = it.getItemset() ;
+
+		pos = bits->size() ;
+
+		bits->resize( pos + W, 0 ) ;
+
+		for( int i = 0; i < vect->size() ; i++ )
+			(*bits)[ pos + (*vect)[ i ] / 64 ] |= (uint64_t)1 << ( (*vect)[ i ] % 64 ) ;
+	}
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  constructor, the minimal transversals of transv
+*  are extended
+*/
+
+template< class Item, int W >
+BitTransversals< Item, W >::BitTransversals( Trie< Item > * transv, Trie< Item > * freqTr )
+{
+	initialised = ( transv->getChildren() != 0 ) ;
+
+	if( initialised )
+		fromTrie( transv, &tr ) ;
+
+	if( ( freqTr != 0 ) && ( freqTr->getChildren() != 0 ) )
+		fromTrie( freqTr, &freq ) ;
+
+	freqIndex.resize( 64 * W ) ;
+
+	for( size_t f = 0; f < freq.size() ; f += W )
+		for( int w = 0; w < W ; w++ )
+			for( uint64_t word = freq[ f + w ]; word != 0 ; word &= word - 1 )
+				freqIndex[ w * 64 + __builtin_ctzll( word ) ].push_back( f ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  tests on the bit vectors, the loops on the W words
+*  are unrolled and vectorised by the compiler
+*/
+
+template< class Item, int W >
+int BitTransversals< Item, W >::count( const uint64_t * s )
+{
+	int res = 0 ;
+
+	for( int w = 0; w < W ; w++ )
+		res += __builtin_popcountll( s[ w ] ) ;
+
+	return res ;
+}
+
+template< class Item, int W >
+bool BitTransversals< Item, W >::intersects( const uint64_t * s1, const uint64_t * s2 )
+{
+	uint64_t res = 0 ;
+
+	for( int w = 0; w < W ; w++ )
+		res |= s1[ w ] & s2[ w ] ;
+
+	return res != 0 ;
+}
+
+template< class Item, int W >
+bool BitTransversals< Item, W >::includedIn( const uint64_t * s1, const uint64_t * s2 )
+{
+	uint64_t res = 0 ;
+
+	for( int w = 0; w < W ; w++ )
+		res |= s1[ w ] & ~s2[ w ] ;
+
+	return res == 0 ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method which calcul the minimal transversal with i+1 edges
+*  from the minimal transversal with i edges and a new edge
+*  ( Demetrovics et Thi approach )
+*  this method is optimised for our problem since it delete 
+*  all the transversal of cardinality >= n-k 
+*                        with n the number of items and
+*                             k the actual level of the
+*								levelwise approach  
+*  and it doesn't generate the supersets of the itemsets of
+*  freqTr ( see Trie::trMinIopt )
+*/
+
+template< class Item, int W >
+void BitTransversals< Item, W >::addEdge( vector< Item > * edge, int n, int k )
+{
+	uint64_t e[ W ] = { 0 } ;	// the edge
+
+	uint64_t cand[ W ] ;		// a new candidate
+
+	const uint64_t * t ;
+
+	unsigned int j ;
+
+	int c ;
+
+	bool minimal ;
+
+	for( j = 0; j < edge->size() ; j++ )
+		e[ (*edge)[ j ] / 64 ] |= (uint64_t)1 << ( (*edge)[ j ] % 64 ) ;
+
+	if( ! initialised )
+	{
+		// the minimal transversals of one edge are its items
+
+		for( j = 0; j < edge->size() ; j++ )
+		{
+			tr.resize( tr.size() + W, 0 ) ;
+
+			tr[ tr.size() - W + (*edge)[ j ] / 64 ] |= (uint64_t)1 << ( (*edge)[ j ] % 64 ) ;
+		}
+
+		initialised = true ;
+
+		return ;
+	}
+
+	// construction of Si and Bi, the transversals of
+	// cardinality >= n-k are deleted and Bi doesn't
+	// get the transversals of cardinality >= n-k-1
+
+	si.clear() ;
+	bi.clear() ;
+
+	for( size_t p = 0; p < tr.size() ; p += W )
+	{
+		t = &tr[ p ] ;
+
+		c = count( t ) ;
+
+		if( c >= n-k )
+			continue ;
+
+		if( intersects( t, e ) )
+			si.insert( si.end(), t, t + W ) ;
+		else if( c < n-k-1 )
+			bi.insert( bi.end(), t, t + W ) ;
+	}
+
+	// an itemset of Bi has no item of the edge so an itemset
+	// of Si included into a candidate has the new item, the
+	// itemsets of Si are indexed by the items of the edge
+
+	index.resize( edge->size() ) ;
+
+	for( j = 0; j < edge->size() ; j++ )
+	{
+		index[ j ].clear() ;
+
+		for( size_t p = 0; p < si.size() ; p += W )
+			if( si[ p + (*edge)[ j ] / 64 ] & ( (uint64_t)1 << ( (*edge)[ j ] % 64 ) ) )
+				index[ j ].push_back( p ) ;
+	}
+
+	// generation of the new transversals
+
+	news.clear() ;
+
+	for( size_t p = 0; p < bi.size() ; p += W )
+	{
+		for( j = 0; j < edge->size() ; j++ )
+		{
+			for( int w = 0; w < W ; w++ )
+				cand[ w ] = bi[ p + w ] ;
+
+			cand[ (*edge)[ j ] / 64 ] |= (uint64_t)1 << ( (*edge)[ j ] % 64 ) ;
+
+			minimal = true ;
+
+			for( unsigned int i = 0; minimal && ( i < index[ j ].size() ) ; i++ )
+				if( includedIn( &si[ index[ j ][ i ] ], cand ) )
+					minimal = false ;
+
+			// no itemset of Bi includes an itemset of freq,
+			// only the ones with the new item are searched
+
+			const vector< unsigned int > & withItem = freqIndex[ (*edge)[ j ] ] ;
+
+			for( unsigned int f = 0; minimal && ( f < withItem.size() ) ; f++ )
+				if( includedIn( &freq[ withItem[ f ] ], cand ) )
+					minimal = false ;
+
+			if( minimal )
+				news.insert( news.end(), cand, cand + W ) ;
+		}
+	}
+
+	tr.swap( si ) ;
+
+	tr.insert( tr.end(), news.begin(), news.end() ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method which replace the itemsets of transv by the
+*  minimal transversals
+*/
+
+template< class Item, int W >
+void BitTransversals< Item, W >::toTrie( Trie< Item > * transv )
+{
+	auto inserter = [ transv ]( vector< Item > * itemset, unsigned int ) { transv->insert( itemset ) ; } ;
+
+	if( ! initialised )
+		return ;
+
+	transv->deleteChildren() ;
+
+	transv->makeChildren() ;
+
+	visitItemsets( inserter ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  number of bytes used by the bit vectors ( the buffers
+*  are counted since they keep their capacity )
+*/
+
+template< class Item, int W >
+size_t BitTransversals< Item, W >::memory() const
+{
+	size_t bytes = ( tr.capacity() + freq.capacity() + si.capacity() + bi.capacity() + news.capacity() ) * sizeof( uint64_t ) ;
+
+	for( size_t i = 0; i < index.size() ; i++ )
+		bytes += index[ i ].capacity() * sizeof( unsigned int ) ;
+
+	for( size_t i = 0; i < freqIndex.size() ; i++ )
+		bytes += freqIndex[ i ].capacity() * sizeof( unsigned int ) ;
+
+	return bytes ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+// instantiation for the item identifiers on 8, 16 and 32 bits
+// and for the universes of 64, 128, 256 and 512 items
+
+template class BitTransversals< unsigned char, 1 > ;
+template class BitTransversals< unsigned char, 2 > ;
+template class BitTransversals< unsigned char, 4 > ;
+template class BitTransversals< unsigned char, 8 > ;
+template class BitTransversals< short unsigned, 1 > ;
+template class BitTransversals< short unsigned, 2 > ;
+template class BitTransversals< short unsigned, 4 > ;
+template class BitTransversals< short unsigned, 8 > ;
+template class BitTransversals< unsigned int, 1 > ;
+template class BitTransversals< unsigned int, 2 > ;
+template class BitTransversals< unsigned int, 4 > ;
+template class BitTransversals< unsigned int, 8 > ;
@@ -0,0 +1,148 @@
+/*----------------------------------------------------------------------
+  File    : BitTransversals.h
+  Contents: Class that calcul the minimal transversals of an hypergraph
+            with the incremental approach of Demetrovics et Thi when
+            the items fit in a few machine words : the transversals
+            and the edges are stored as bit vectors of W words so the
+            intersection and inclusion tests are done word by word
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#ifndef BITTRANSVERSALS_H
+#define BITTRANSVERSALS_H
+
+#include "Trie.h"
+
+#include <cstdint>
+
+template< class Item, int W >
+class BitTransversals
+{
+protected:
+
+	// ------------------------------------------------
+	// minimal transversals, W words by itemset, and
+	// the itemsets of freqTr ( their supersets are
+	// not generated )
+	// ------------------------------------------------
+
+	vector< uint64_t > tr ;
+
+	vector< uint64_t > freq ;
+
+	// ------------------------------------------------
+	// for each item, position of the itemsets of freq
+	// including it ( see SubsetIndex )
+	// ------------------------------------------------
+
+	vector< vector< unsigned int > > freqIndex ;
+
+	// ---------------------------------------------
+	// false until the first edge has been added
+	// ---------------------------------------------
+
+	bool initialised ;
+
+	// ------------------------------------------------
+	// buffers reused for all the edges : Si, Bi, the
+	// new transversals and for each item of the edge
+	// the itemsets of Si including it
+	// ------------------------------------------------
+
+	vector< uint64_t > si ;
+
+	vector< uint64_t > bi ;
+
+	vector< uint64_t > news ;
+
+	vector< vector< unsigned int > > index ;
+
+	void fromTrie( Trie< Item > * trie, vector< uint64_t > * bits ) ;
+
+	static int count( const uint64_t * s ) ;
+
+	static bool intersects( const uint64_t * s1, const uint64_t * s2 ) ;
+
+	// -------------------------------------
+	// true if s1 is included into s2
+	// -------------------------------------
+
+	static bool includedIn( const uint64_t * s1, const uint64_t * s2 ) ;
+
+public:
+
+	// -------------------------------------------------
+	// the minimal transversals of transv are extended
+	// ( transv has no children if there is no edge yet )
+	// -------------------------------------------------
+
+	BitTransversals( Trie< Item > * transv, Trie< Item > * freqTr = 0 ) ;
+
+	// ----------------------------------------------------------
+	// method which calcul the minimal transversal with i+1 edges
+	// from the minimal transversal with i edges and a new edge
+	// ( same result as Trie::trMinIopt )
+	// ----------------------------------------------------------
+
+	void addEdge( vector< Item > * edge, int n, int k ) ;
+
+	unsigned int getSupport() const { return tr.size() / W ; }
+
+	// ---------------------------------------------------
+	// method which replace the itemsets of transv by the
+	// minimal transversals
+	// ---------------------------------------------------
+
+	void toTrie( Trie< Item > * transv ) ;
+
+	// ------------------------------------------------------
+	// method applying a visitor to all the transversals :
+	//		visitor( itemset, 0 )
+	// ------------------------------------------------------
+
+	template< class Visitor >
+	void visitItemsets( Visitor & visitor ) ;
+
+	// ---------------------------------------------
+	// number of bytes used by the bit vectors
+	// ---------------------------------------------
+
+	size_t memory() const ;
+
+	// ---------------------------------------------
+	// true if the items 0 to nbItems-1 fit in the
+	// bit vectors
+	// ---------------------------------------------
+
+	static bool fits( int nbItems ) { return nbItems <= 64 * W ; }
+
+};
+
+// ----------------------------------------------------------------------------------------------
+
+template< class Item, int W >
+template< class Visitor >
+void BitTransversals< Item, W >::visitItemsets( Visitor & visitor )
+{
+	vector< Item > itemset ;
+
+	uint64_t word ;
+
+	if( ! initialised )
+		return ;
+
+	for( size_t p = 0; p < tr.size() ; p += W )
+	{
+		itemset.clear() ;
+
+		// the items are found in increasing order
+
+		for( int w = 0; w < W ; w++ )
+			for( word = tr[ p + w ]; word != 0 ; word &= word - 1 )
+				itemset.push_back( w * 64 + __builtin_ctzll( word ) ) ;
+
+		visitor( &itemset, 0 ) ;
+	}
+}
+
+#endif
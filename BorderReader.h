@@ -0,0 +1,217 @@
+/*----------------------------------------------------------------------
+  File    : BorderReader.h
+  Contents: Class that read the positive border saved in binary by
+            fim_maximal ( option -bin, see BorderWriter ). The file is
+            mapped in memory and the itemsets are decoded one after the
+            other, this header doesn't need the other files of ABS.
+            Format ( all the numbers are coded on a variable number of
+            bytes, 7 bits by byte, the high bit is set on all the bytes
+            except the last one ) :
+              - the 8 characters ABSBORD1
+              - the number n of items, then the name of the item of
+                each internal id from 0 to n-1 ( n is 0 if the names
+                are the ids )
+              - for each itemset, in the order of the trie : the number
+                of items shared with the previous itemset, the number
+                of the other items, these items ( their ids, each one
+                as the difference with the previous id minus 1 ) and
+                the support
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#ifndef BORDERREADER_H
+#define BORDERREADER_H
+
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+static const char BORDER_MAGIC[] = "ABSBORD1" ;
+
+class BorderReader
+{
+protected:
+
+	const unsigned char * data ;	// file mapped
+
+	size_t size ;
+
+	const unsigned char * pos ;		// next byte to read
+
+	const unsigned char * first ;	// first itemset
+
+	// ------------------------------------------------
+	// names of the internal ids ( empty if the names
+	// are the ids ), ids and names of the items of the
+	// current itemset and its support
+	// ------------------------------------------------
+
+	vector< int > names ;
+
+	vector< unsigned int > ids ;
+
+	vector< int > items ;
+
+	unsigned long support ;
+
+	bool readNumber( unsigned long & number )
+	{
+		int shift = 0 ;
+
+		number = 0 ;
+
+		while( pos < data + size )
+		{
+			number |= (unsigned long)( *pos & 0x7F ) << shift ;
+
+			if( ( *pos++ & 0x80 ) == 0 )
+				return true ;
+
+			shift += 7 ;
+		}
+
+		return false ;
+	}
+
+public:
+
+	BorderReader() : data( 0 ), size( 0 ), pos( 0 ), first( 0 ), support( 0 ) {}
+
+	~BorderReader() { close() ; }
+
+	// ------------------------------------------------
+	// method that map the file and read the names of
+	// the items, return false if the file can't be
+	// mapped or is not a border file
+	// ------------------------------------------------
+
+	bool open( const char * fileName )
+	{
+		struct stat info ;
+
+		unsigned long nbNames, name ;
+
+		int fd ;
+
+		close() ;
+
+		if( ( fd = ::open( fileName, O_RDONLY ) ) < 0 )
+			return false ;
+
+		if( ( fstat( fd, &info ) != 0 ) || ( info.st_size < 8 ) )
+		{
+			::close( fd ) ;
+			return false ;
+		}
+
+		size = info.st_size ;
+
+		void * map = mmap( 0, size, PROT_READ, MAP_PRIVATE, fd, 0 ) ;
+
+		::close( fd ) ;
+
+		if( map == MAP_FAILED )
+			return false ;
+
+		data = (const unsigned char *)map ;
+
+		pos = data + 8 ;
+
+		if( ( memcmp( data, BORDER_MAGIC, 8 ) != 0 ) || ! readNumber( nbNames ) )
+		{
+			close() ;
+			return false ;
+		}
+
+		for( unsigned long i = 0; i < nbNames ; i++ )
+		{
+			if( ! readNumber( name ) )
+			{
+				close() ;
+				return false ;
+			}
+
+			names.push_back( (int)name ) ;
+		}
+
+		first = pos ;
+
+		return true ;
+	}
+
+	void close()
+	{
+		if( data != 0 )
+			munmap( (void *)data, size ) ;
+
+		data = 0 ;
+		size = 0 ;
+		pos = 0 ;
+		first = 0 ;
+
+		names.clear() ;
+		ids.clear() ;
+		items.clear() ;
+	}
+
+	bool isOpen() const { return data != 0 ; }
+
+	// ------------------------------------------------
+	// method that go back before the first itemset
+	// ------------------------------------------------
+
+	void reset() { pos = first ; ids.clear() ; items.clear() ; }
+
+	// ------------------------------------------------
+	// method that read the next itemset, return false
+	// at the end of the file
+	// ------------------------------------------------
+
+	bool next()
+	{
+		unsigned long prefix, nbNew, delta ;
+
+		unsigned int id ;
+
+		if( ( data == 0 ) || ! readNumber( prefix ) || ! readNumber( nbNew ) || ( prefix > ids.size() ) )
+			return false ;
+
+		ids.resize( prefix ) ;
+		items.resize( prefix ) ;
+
+		for( unsigned long i = 0; i < nbNew ; i++ )
+		{
+			if( ! readNumber( delta ) )
+				return false ;
+
+			id = ids.empty() ? delta : ids.back() + delta + 1 ;
+
+			ids.push_back( id ) ;
+
+			items.push_back( names.empty() ? (int)id : names[ id ] ) ;
+		}
+
+		return readNumber( support ) ;
+	}
+
+	// ---------------------------------
+	// method returning the attributes
+	// ---------------------------------
+
+	const vector< int > & getItemset() const { return items ; }
+
+	const vector< unsigned int > & getIds() const { return ids ; }
+
+	const vector< int > & getNames() const { return names ; }
+
+	unsigned long getSupport() const { return support ; }
+
+};
+
+#endif
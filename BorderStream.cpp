@@ -0,0 +1,155 @@
+/*----------------------------------------------------------------------
+  File    : BorderStream.cpp
+  Contents: Class that write the itemsets of the positive border into
+            the output file as soon as they are known to be maximal,
+            while the mining goes on : the itemsets are queued by the
+            algorithm and written by a thread, and the file is flushed
+            after each batch so that another program can read it
+            during the run ( for example through a named pipe )
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "BorderStream.h"
+
+/**
+*  method that create ( or truncate ) the file and
+*  start the thread writing the itemsets queued
+*/
+
+template< class Item >
+bool BorderStream< Item >::open( const char * fileName, int * remap, int nbItems, SinkMode mode, bool inBinary )
+{
+	close() ;
+
+	binary = inBinary ;
+
+	if( binary )
+	{
+		if( ! binaryFile.open( fileName, remap, nbItems, mode ) )
+			return false ;
+	}
+	else
+	{
+		if( ! sink.open( fileName, mode ) )
+			return false ;
+
+		sink.setRemap( remap ) ;
+	}
+
+	closing = false ;
+
+	nbItemsets = 0 ;
+
+	writer = thread( &BorderStream< Item >::writeQueued, this ) ;
+
+	return true ;
+}
+
+/**
+*  method that queue a maximal itemset, the thread
+*  is woken up to write it
+*/
+
+template< class Item >
+void BorderStream< Item >::push( vector< Item > * itemset, int supp )
+{
+	if( ! isOpen() )
+		return ;
+
+	{
+		lock_guard< mutex > guard( lock ) ;
+
+		queue.push_back( make_pair( *itemset, supp ) ) ;
+	}
+
+	nbItemsets++ ;
+
+	ready.notify_one() ;
+}
+
+/**
+*  method that write the itemsets left, stop
+*  the thread and close the file
+*/
+
+template< class Item >
+void BorderStream< Item >::close()
+{
+	if( ! isOpen() )
+		return ;
+
+	{
+		lock_guard< mutex > guard( lock ) ;
+
+		closing = true ;
+	}
+
+	ready.notify_one() ;
+
+	writer.join() ;
+
+	if( binary )
+		binaryFile.close() ;
+	else
+		sink.close() ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  loop of the thread : the itemsets queued are taken all
+*  at once and written without holding the lock, in the
+*  same format as Trie::saveItemsets, then the file is
+*  flushed so that the reader sees them
+*/
+
+template< class Item >
+void BorderStream< Item >::writeQueued()
+{
+	vector< pair< vector< Item >, int > > batch ;
+
+	bool last = false ;
+
+	while( ! last )
+	{
+		{
+			unique_lock< mutex > guard( lock ) ;
+
+			ready.wait( guard, [ this ]{ return ! queue.empty() || closing ; } ) ;
+
+			batch.swap( queue ) ;
+
+			last = closing ;
+		}
+
+		for( unsigned int i = 0; ( i < batch.size() ) && binary ; i++ )
+			binaryFile.write( &batch[ i ].first, batch[ i ].second ) ;
+
+		for( unsigned int i = 0; ( i < batch.size() ) && ! binary ; i++ )
+		{
+			vector< Item > & itemset = batch[ i ].first ;
+
+			for( unsigned int j = 0; j < itemset.size() ; j++ )
+				sink.putItem( itemset[ j ] ) ;
+
+			sink.putChar( '(' ) ;
+			sink.putNumber( batch[ i ].second ) ;
+			sink.putText( ")\n" ) ;
+		}
+
+		if( binary )
+			binaryFile.flush() ;
+		else
+			sink.flush() ;
+
+		batch.clear() ;
+	}
+}
+
+// ----------------------------------------------------------------------------------------------
+
+// instantiation for the item identifiers on 8, 16 and 32 bits
+
+template class BorderStream< unsigned char > ;
+template class BorderStream< short unsigned > ;
+template class BorderStream< unsigned int > ;
@@ -0,0 +1,98 @@
+/*----------------------------------------------------------------------
+  File    : BorderStream.h
+  Contents: Class that write the itemsets of the positive border into
+            the output file as soon as they are known to be maximal,
+            while the mining goes on : the itemsets are queued by the
+            algorithm and written by a thread, and the file is flushed
+            after each batch so that another program can read it
+            during the run ( for example through a named pipe )
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#ifndef BORDERSTREAM_H
+#define BORDERSTREAM_H
+
+#include "BorderWriter.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+template< class Item >
+class BorderStream
+{
+protected:
+
+	// ------------------------------------------------
+	// text file, or binary file if binary is true
+	// ------------------------------------------------
+
+	OutputSink sink ;
+
+	BorderWriter< Item > binaryFile ;
+
+	bool binary ;
+
+	// ------------------------------------------------
+	// itemsets with their support waiting to be
+	// written, and true once close is called
+	// ------------------------------------------------
+
+	vector< pair< vector< Item >, int > > queue ;
+
+	bool closing ;
+
+	mutex lock ;
+
+	condition_variable ready ;
+
+	thread writer ;
+
+	unsigned long nbItemsets ;	// number of itemsets queued
+
+	void writeQueued() ;
+
+public:
+
+	BorderStream() : binary( false ), closing( false ), nbItemsets( 0 ) {}
+
+	~BorderStream() { close() ; }
+
+	// ------------------------------------------------
+	// method that create ( or truncate ) the file and
+	// start the thread, return false if the file can't
+	// be opened ( remap maps the ids of the nbItems
+	// items to their names, mode is the way the file
+	// is written and inBinary chooses the format of
+	// BorderWriter )
+	// ------------------------------------------------
+
+	bool open( const char * fileName, int * remap, int nbItems, SinkMode mode = SINK_WRITE, bool inBinary = false ) ;
+
+	// ------------------------------------------------
+	// true between open and close ( the file itself
+	// is only used by the thread meanwhile )
+	// ------------------------------------------------
+
+	bool isOpen() const { return writer.joinable() ; }
+
+	// ------------------------------------------------
+	// method that queue a maximal itemset ( the items
+	// are copied )
+	// ------------------------------------------------
+
+	void push( vector< Item > * itemset, int supp ) ;
+
+	// ------------------------------------------------
+	// method that write the itemsets left, stop the
+	// thread and close the file
+	// ------------------------------------------------
+
+	void close() ;
+
+	unsigned long getNbItemsets() const { return nbItemsets ; }
+
+};
+
+#endif
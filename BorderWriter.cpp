@@ -0,0 +1,100 @@
+/*----------------------------------------------------------------------
+  File    : BorderWriter.cpp
+  Contents: Class that write the positive border in a binary file : the
+            itemsets are written in the order of the trie, each one as
+            the items that are not shared with the previous one and its
+            support, all the numbers are coded on a variable number of
+            bytes ( see BorderReader.h for the format )
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "BorderWriter.h"
+
+/**
+*  method that create ( or truncate ) the file and
+*  write its header and the names of the items
+*/
+
+template< class Item >
+bool BorderWriter< Item >::open( const char * fileName, int * remap, int nbItems, SinkMode mode )
+{
+	if( ! sink.open( fileName, mode ) )
+		return false ;
+
+	previous.clear() ;
+
+	nbItemsets = 0 ;
+
+	sink.putText( BORDER_MAGIC ) ;
+
+	if( remap == 0 )
+		nbItems = 0 ;
+
+	writeNumber( nbItems ) ;
+
+	for( int i = 0; i < nbItems ; i++ )
+		writeNumber( remap[ i ] ) ;
+
+	return true ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  write a number on as many bytes as needed, 7 bits
+*  by byte, the high bit is set on all the bytes
+*  except the last one
+*/
+
+template< class Item >
+void BorderWriter< Item >::writeNumber( unsigned long number )
+{
+	while( number >= 0x80 )
+	{
+		sink.putChar( (char)( ( number & 0x7F ) | 0x80 ) ) ;
+
+		number >>= 7 ;
+	}
+
+	sink.putChar( (char)number ) ;
+}
+
+/**
+*  method that append an itemset to the file, only the
+*  items after the prefix shared with the previous itemset
+*  are written, as the difference with the item before
+*/
+
+template< class Item >
+void BorderWriter< Item >::write( vector< Item > * itemset, unsigned long support )
+{
+	unsigned int prefix = 0 ;
+
+	while( ( prefix < previous.size() ) && ( prefix < itemset->size() ) && ( previous[ prefix ] == (*itemset)[ prefix ] ) )
+		prefix++ ;
+
+	writeNumber( prefix ) ;
+	writeNumber( itemset->size() - prefix ) ;
+
+	for( unsigned int i = prefix; i < itemset->size() ; i++ )
+	{
+		if( i == 0 )
+			writeNumber( (*itemset)[ i ] ) ;
+		else
+			writeNumber( (*itemset)[ i ] - (*itemset)[ i - 1 ] - 1 ) ;
+	}
+
+	writeNumber( support ) ;
+
+	previous = *itemset ;
+
+	nbItemsets++ ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+// instantiation for the item identifiers on 8, 16 and 32 bits
+
+template class BorderWriter< unsigned char > ;
+template class BorderWriter< short unsigned > ;
+template class BorderWriter< unsigned int > ;
@@ -0,0 +1,64 @@
+/*----------------------------------------------------------------------
+  File    : BorderWriter.h
+  Contents: Class that write the positive border in a binary file : the
+            itemsets are written in the order of the trie, each one as
+            the items that are not shared with the previous one and its
+            support, all the numbers are coded on a variable number of
+            bytes ( see BorderReader.h for the format )
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#ifndef BORDERWRITER_H
+#define BORDERWRITER_H
+
+#include "Trie.h"
+#include "BorderReader.h"
+
+template< class Item >
+class BorderWriter
+{
+protected:
+
+	OutputSink sink ;
+
+	vector< Item > previous ;	// last itemset written
+
+	unsigned long nbItemsets ;
+
+	void writeNumber( unsigned long number ) ;
+
+public:
+
+	BorderWriter() : nbItemsets( 0 ) {}
+
+	// ------------------------------------------------
+	// method that create ( or truncate ) the file and
+	// write the names of the nbItems items given by
+	// remap ( if remap is 0 the names are the ids ),
+	// return false if the file can't be opened
+	// ------------------------------------------------
+
+	bool open( const char * fileName, int * remap, int nbItems, SinkMode mode = SINK_WRITE ) ;
+
+	bool isOpen() const { return sink.isOpen() ; }
+
+	void close() { sink.close() ; }
+
+	// ---------------------------------------------
+	// method that append an itemset to the file
+	// ( the items MUST BE ordered )
+	// ---------------------------------------------
+
+	void write( vector< Item > * itemset, unsigned long support ) ;
+
+	void operator()( vector< Item > * itemset, Trie< Item > * node ) { write( itemset, node->getSupport() ) ; }
+
+	void flush() { sink.flush() ; }
+
+	unsigned long getNbItemsets() const { return nbItemsets ; }
+
+	bool good() const { return sink.good() ; }
+
+};
+
+#endif
@@ -0,0 +1,49 @@
+/*----------------------------------------------------------------------
+  File    : Budget.cpp
+  Contents: Class that check if a run has exceeded its budget of wall
+            time or of memory ( resident memory of the process ). ABS
+            keeps explicit positive and negative borders, so it checks
+            the budget at safe points and stops there with the maximal
+            itemsets already found
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "Budget.h"
+
+#include <fstream>
+#include <unistd.h>
+
+/**
+*  method called at a safe point, once a limit is
+*  reached the next calls return true too
+*/
+
+bool Budget::exceeded()
+{
+	if( reason != 0 )
+		return true ;
+
+	if( ( seconds > 0 ) && ( getElapsed() >= seconds ) )
+		reason = "time" ;
+	else if( ( bytes > 0 ) && ( residentBytes() >= bytes ) )
+		reason = "memory" ;
+
+	return reason != 0 ;
+}
+
+/**
+*  resident memory of the process, read from the second
+*  field of /proc/self/statm ( number of pages )
+*/
+
+size_t Budget::residentBytes()
+{
+	ifstream statm( "/proc/self/statm" ) ;
+
+	size_t size, resident ;
+
+	if( ! ( statm >> size >> resident ) )
+		return 0 ;
+
+	return resident * sysconf( _SC_PAGESIZE ) ;
+}
@@ -0,0 +1,78 @@
+/*----------------------------------------------------------------------
+  File    : Budget.h
+  Contents: Class that check if a run has exceeded its budget of wall
+            time or of memory ( resident memory of the process ). ABS
+            keeps explicit positive and negative borders, so it checks
+            the budget at safe points and stops there with the maximal
+            itemsets already found
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#ifndef BUDGET_H
+#define BUDGET_H
+
+#include <chrono>
+#include <cstddef>
+
+using namespace std;
+
+class Budget
+{
+protected:
+
+	// ------------------------------------------------
+	// limits ( 0 for no limit )
+	// ------------------------------------------------
+
+	double seconds ;
+
+	size_t bytes ;
+
+	chrono::steady_clock::time_point begin ;
+
+	// ------------------------------------------------
+	// reason of the stop ( 0 until a limit is reached,
+	// it stays set then )
+	// ------------------------------------------------
+
+	const char * reason ;
+
+public:
+
+	Budget() : seconds( 0 ), bytes( 0 ), reason( 0 ) {}
+
+	// ---------------------------------------------
+	// method initializing the limits
+	// ---------------------------------------------
+
+	void setLimits( double inSeconds, size_t inBytes ) { seconds = inSeconds ; bytes = inBytes ; }
+
+	bool isSet() const { return ( seconds > 0 ) || ( bytes > 0 ) ; }
+
+	// ---------------------------------------------
+	// method called at the beginning of the run
+	// ---------------------------------------------
+
+	void start() { begin = chrono::steady_clock::now() ; reason = 0 ; }
+
+	// ------------------------------------------------
+	// method called at a safe point, return true if
+	// a limit is reached ( or has been reached )
+	// ------------------------------------------------
+
+	bool exceeded() ;
+
+	const char * getReason() const { return reason ; }
+
+	double getElapsed() const { return chrono::duration< double >( chrono::steady_clock::now() - begin ).count() ; }
+
+	// ------------------------------------------------
+	// resident memory of the process ( 0 if it can't
+	// be read )
+	// ------------------------------------------------
+
+	static size_t residentBytes() ;
+
+};
+
+#endif
@@ -0,0 +1,313 @@
+/*----------------------------------------------------------------------
+  File    : CompactTrie.cpp
+  Contents: Class that represent a read only prefix trie stored in
+            parallel arrays (id, support, first child, number of
+            children) indexed by the number of the node. The children
+            of a node are contiguous and ordered wrt their id.
+            It is used to keep sets of itemsets that are no more
+            modified with less memory than a Trie
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "CompactTrie.h"
+
+/**
+*  method that store the itemsets of trie, the nodes
+*  are numbered in breadth first order so the children
+*  of a node are contiguous
+*/
+
+template< class Item >
+void CompactTrie< Item >::build( Trie< Item > * trie )
+{
+	vector< Trie< Item > * > nodes ;	// node of the trie for each number
+
+	set< Trie< Item > > * items ;
+
+	clear() ;
+
+	nodes.push_back( trie ) ;
+	ids.push_back( trie->getId() ) ;
+	supports.push_back( trie->getSupport() ) ;
+
+	for( unsigned int i = 0; i < nodes.size() ; i++ )
+	{
+		items = nodes[ i ]->getChildren() ;
+
+		firstChild.push_back( ids.size() ) ;
+
+		if( ( items == 0 ) || items->empty() )
+		{
+			childCount.push_back( 0 ) ;
+
+			if( i != 0 )
+				nbItemsets++ ;
+		}
+		else
+		{
+			childCount.push_back( items->size() ) ;
+
+			for( typename set< Trie< Item > >::iterator runner = items->begin(); runner != items->end(); runner++ )
+			{
+				nodes.push_back( const_cast< Trie< Item > * >( &(*runner) ) ) ;
+				ids.push_back( runner->getId() ) ;
+				supports.push_back( runner->getSupport() ) ;
+			}
+		}
+	}
+
+	// the arrays are not modified anymore
+
+	ids.shrink_to_fit() ;
+	supports.shrink_to_fit() ;
+	firstChild.shrink_to_fit() ;
+	childCount.shrink_to_fit() ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that delete all the nodes
+*/
+
+template< class Item >
+void CompactTrie< Item >::clear()
+{
+	vector< Item >().swap( ids ) ;
+	vector< unsigned int >().swap( supports ) ;
+	vector< unsigned int >().swap( firstChild ) ;
+	vector< unsigned int >().swap( childCount ) ;
+
+	nbItemsets = 0 ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  number of bytes used to store the nodes
+*/
+
+template< class Item >
+size_t CompactTrie< Item >::memory() const
+{
+	return ids.capacity() * sizeof( Item )
+		+ ( supports.capacity() + firstChild.capacity() + childCount.capacity() ) * sizeof( unsigned int ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method searching if itemset is include in one
+*  of the itemsets of the sub tree of node
+*/
+
+template< class Item >
+bool CompactTrie< Item >::include( unsigned int node, vector< Item > * itemset, int spos )
+{
+	bool res = false ; // result of the inclusion test
+
+	unsigned int child, end ;
+
+	if( ( childCount[ node ] != 0 ) && ( spos != itemset->size() ) )
+	{
+		child = firstChild[ node ] ;
+
+		end = child + childCount[ node ] ;
+
+		while( ( res == false ) && ( child != end ) && ( ids[ child ] <= (*itemset)[ spos ] ) )
+		{
+			if( ids[ child ] == (*itemset)[ spos ] )
+				res = include( child, itemset, spos + 1 ) ;
+			else
+				res = include( child, itemset, spos ) ;
+
+			child++ ;
+		}
+	}
+	else
+		// we have found all the items if itemset
+
+		if ( spos == itemset->size() )
+			res = true ;
+
+	return res ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method searching if one itemset of the sub tree
+*  of node is included into itemset
+*/
+
+template< class Item >
+bool CompactTrie< Item >::includedIn( unsigned int node, vector< Item > * itemset, int spos )
+{
+	bool res = false ; // result of the inclusion test
+
+	unsigned int child, end ;
+
+	if( childCount[ node ] == 0 )
+		// we have check all the item of the current itemset
+		// of this set
+		return ( node != 0 ) ;
+
+	child = firstChild[ node ] ;
+
+	end = child + childCount[ node ] ;
+
+	while( ( res == false ) && ( child != end ) && ( spos < itemset->size() ) )
+	{
+		// the itemsets are ordered so we skip
+		// the items of itemset smaller than the
+		// item of the current child
+
+		while( ( spos < itemset->size() ) && ( (*itemset)[ spos ] < ids[ child ] ) )
+			spos++ ;
+
+		if( ( spos < itemset->size() ) && ( (*itemset)[ spos ] == ids[ child ] ) )
+			res = includedIn( child, itemset, spos + 1 ) ;
+
+		child++ ;
+	}
+
+	return res ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  functor inserting an itemset and its support in a trie
+*/
+
+template< class Item >
+struct TrieInserter
+{
+	Trie< Item > * trie ;
+
+	TrieInserter( Trie< Item > * inTrie ) : trie( inTrie ) {}
+
+	void operator()( vector< Item > * itemset, unsigned int support )
+	{
+		trie->insert( itemset, support ) ;
+	}
+};
+
+/**
+*  method which insert all the itemsets of this
+*  set in a trie ( with their support )
+*/
+
+template< class Item >
+void CompactTrie< Item >::insertInto( Trie< Item > * trie )
+{
+	TrieInserter< Item > inserter( trie ) ;
+
+	visitItemsets( inserter ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  functor writing an itemset and its support into a file
+*/
+
+template< class Item >
+struct CompactItemsetWriter
+{
+	OutputSink & sink ;
+
+	CompactItemsetWriter( OutputSink & inSink ) : sink( inSink ) {}
+
+	void operator()( vector< Item > * vect, unsigned int support )
+	{
+		for( int j = 0; j < vect->size() ; j++ )
+			sink.putItem( (*vect)[ j ] ) ;
+
+		sink.putChar( '(' ) ;
+		sink.putNumber( support ) ;
+		sink.putText( ")\n" ) ;
+	}
+};
+
+/**
+*  save into a file all the itemset stored in tree
+*  remap is a table for mapping the name of the items
+*  if remap is 0 it use the internal id
+*/
+
+template< class Item >
+void CompactTrie< Item >::saveItemsets( const char * fileName, int * remap, SinkMode mode )
+{
+	OutputSink sink ;
+
+	if( sink.open( fileName, mode ) )
+	{
+		CompactItemsetWriter< Item > writer( sink ) ;
+
+		sink.setRemap( remap ) ;
+
+		visitItemsets( writer ) ;
+
+		sink.close()  ;
+	}
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  functor adding an edge to the minimal transversals
+*/
+
+template< class Item >
+struct TransversalBuilder
+{
+	Trie< Item > * res ;
+
+	int n ;
+
+	int k ;
+
+	int nbThreads ;
+
+	TransversalBuilder( Trie< Item > * inRes, int inN, int inK, int inNbThreads ) : res( inRes ), n( inN ), k( inK ), nbThreads( inNbThreads ) {}
+
+	void operator()( vector< Item > * edge, unsigned int )
+	{
+		if ( res->getChildren() == 0 )
+			res->initTr( edge ) ;
+		else
+			res->trMinIopt( edge, n, k, 0, nbThreads ) ;
+	}
+};
+
+/**
+*  method which calcul the minimal transversal of this set of
+*  itemset
+*  this method is optimised for our problem since it delete
+*  all the transversal of cardinality >= n-k
+*                        with n the number of items and
+*                             k the actual level of the
+*								levelwise approach
+*  nbThreads threads are used to generate the new transversals
+*/
+
+template< class Item >
+Trie< Item > * CompactTrie< Item >::trMinOpt( int n, int k, int nbThreads )
+{
+	Trie< Item > * res = new Trie< Item >( 0 ) ;
+
+	TransversalBuilder< Item > builder( res, n, k, nbThreads ) ;
+
+	visitItemsets( builder ) ;
+
+	return res ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+// instantiation for the item identifiers on 8, 16 and 32 bits
+
+template class CompactTrie< unsigned char > ;
+template class CompactTrie< short unsigned > ;
+template class CompactTrie< unsigned int > ;
@@ -0,0 +1,190 @@
+/*----------------------------------------------------------------------
+  File    : CompactTrie.h
+  Contents: Class that represent a read only prefix trie stored in
+            parallel arrays (id, support, first child, number of
+            children) indexed by the number of the node. The children
+            of a node are contiguous and ordered wrt their id.
+            It is used to keep sets of itemsets that are no more
+            modified with less memory than a Trie
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#ifndef COMPACTTRIE_H
+#define COMPACTTRIE_H
+
+#include "Trie.h"
+
+template< class Item >
+class CompactTrie
+{
+protected:
+
+	// ----------------------------------------
+	// identifier of the item of each node
+	// ( the node 0 is the root of the trie )
+	// ----------------------------------------
+
+	vector< Item > ids ;
+
+	// -------------------------------------------
+	// support of the itemset ending at each node
+	// -------------------------------------------
+
+	vector< unsigned int > supports ;
+
+	// -----------------------------------------------
+	// number of the first child and number of child
+	// nodes of each node
+	// -----------------------------------------------
+
+	vector< unsigned int > firstChild ;
+
+	vector< unsigned int > childCount ;
+
+	// -----------------------------------
+	// number of itemsets ( ie of leaves )
+	// -----------------------------------
+
+	unsigned int nbItemsets ;
+
+	bool include( unsigned int node, vector< Item > * itemset, int spos ) ;
+
+	bool includedIn( unsigned int node, vector< Item > * itemset, int spos ) ;
+
+public:
+
+	CompactTrie() : nbItemsets( 0 ) {}
+
+	CompactTrie( Trie< Item > * trie ) : nbItemsets( 0 ) { build( trie ) ; }
+
+	// --------------------------------------------------
+	// method that store the itemsets of trie, the nodes
+	// are numbered in breadth first order
+	// --------------------------------------------------
+
+	void build( Trie< Item > * trie ) ;
+
+	void clear() ;
+
+	// ---------------------------------
+	// method returning the attributes
+	// ---------------------------------
+
+	unsigned int getSupport() const { return nbItemsets ; }
+
+	unsigned int getNbNodes() const { return ids.size() ; }
+
+	// ----------------------------------------
+	// number of bytes used to store the nodes
+	// ----------------------------------------
+
+	size_t memory() const ;
+
+	// ----------------------------------------------
+	// method searching if itemset is include in one
+	// of the itemsets of this set of itemset
+	// ----------------------------------------------
+
+	bool include( vector< Item > * itemset ) { return include( 0, itemset, 0 ) ; }
+
+	// ---------------------------------------------
+	// method searching if one itemset of this set
+	// is included into itemset
+	// ---------------------------------------------
+
+	bool includedIn( vector< Item > * itemset ) { return includedIn( 0, itemset, 0 ) ; }
+
+	// ------------------------------------------------------
+	// method applying a visitor to all the itemsets
+	// in depth first order :   visitor( itemset, support )
+	// ------------------------------------------------------
+
+	template< class Visitor >
+	void visitItemsets( Visitor & visitor ) ;
+
+	// ---------------------------------------------
+	// method which insert all the itemsets of this
+	// set in a trie ( with their support )
+	// ---------------------------------------------
+
+	void insertInto( Trie< Item > * trie ) ;
+
+	// ---------------------------------------------------
+	// save into a file all the itemset stored in tree
+	// remap is a table for mapping the name of the items
+	// if remap is 0 it use the internal id
+	// mode is the way the file is written ( OutputSink )
+	// ---------------------------------------------------
+
+	void saveItemsets( const char * fileName, int * remap = 0, SinkMode mode = SINK_WRITE ) ;
+
+	// -----------------------------------------------------------
+	// method which calcul the minimal transversal of this set of
+	// itemset ( see Trie::trMinOpt ) with nbThreads threads
+	// -----------------------------------------------------------
+
+	Trie< Item > * trMinOpt( int n, int k, int nbThreads = 1 ) ;
+
+};
+
+// ----------------------------------------------------------------------------------------------
+
+template< class Item >
+template< class Visitor >
+void CompactTrie< Item >::visitItemsets( Visitor & visitor )
+{
+	vector< unsigned int > path ;		// nodes of the current itemset
+
+	vector< Item > itemset ;	// items of the current itemset
+
+	unsigned int node ;
+
+	unsigned int parent ;
+
+	if( ids.empty() || ( childCount[ 0 ] == 0 ) )
+		return ;
+
+	node = firstChild[ 0 ] ;
+
+	path.push_back( node ) ;
+	itemset.push_back( ids[ node ] ) ;
+
+	while( ! path.empty() )
+	{
+		node = path.back() ;
+
+		if( childCount[ node ] != 0 )	// we go down to the first child
+		{
+			node = firstChild[ node ] ;
+
+			path.push_back( node ) ;
+			itemset.push_back( ids[ node ] ) ;
+
+			continue ;
+		}
+
+		visitor( &itemset, supports[ node ] ) ;
+
+		// we go up until a node has a next sibling
+
+		while( ! path.empty() )
+		{
+			node = path.back() ;
+
+			path.pop_back() ;
+			itemset.pop_back() ;
+
+			parent = path.empty() ? 0 : path.back() ;
+
+			if( node + 1 < firstChild[ parent ] + childCount[ parent ] )
+			{
+				path.push_back( node + 1 ) ;
+				itemset.push_back( ids[ node + 1 ] ) ;
+
+				break ;
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,377 @@
+/*----------------------------------------------------------------------
+  File    : ExternalTransversals.cpp
+  Contents: Class that calcul the minimal transversals of an hypergraph
+            with the incremental approach of Demetrovics et Thi when
+            they don't fit in the memory budget : the transversals are
+            kept in files ( see ItemsetFile ) and for each edge Si and
+            Bi are written in files and read back by batches, so only
+            a part of the transversals is loaded in tries at any time
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "ExternalTransversals.h"
+#include "TrieIterator.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+/**
+*  the names of the files are made unique with the
+*  process id and a counter of the instances
+*/
+
+template< class Item >
+ExternalTransversals< Item >::ExternalTransversals( const char * dir, size_t inBudget )
+	: budget( inBudget ), nbItemsets( 0 ), nbItems( 0 )
+{
+	static int nbInstances = 0 ;
+
+	string prefix = string( dir ) + "/fim_transv_" + to_string( getpid() ) + "_" + to_string( nbInstances++ ) ;
+
+	trName = prefix + "_tr" ;
+	nextName = prefix + "_next" ;
+	siName = prefix + "_si" ;
+	biName = prefix + "_bi" ;
+
+	created = writer.open( trName.c_str() ) ;
+}
+
+template< class Item >
+ExternalTransversals< Item >::~ExternalTransversals()
+{
+	writer.close() ;
+
+	remove( trName.c_str() ) ;
+	remove( nextName.c_str() ) ;
+	remove( siName.c_str() ) ;
+	remove( biName.c_str() ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  the itemsets of transv are written one by one and
+*  deleted from transv, so the memory is given back
+*  while the file grows
+*/
+
+template< class Item >
+void ExternalTransversals< Item >::spill( Trie< Item > * transv )
+{
+	TrieIterator< Item > it( transv ) ;
+
+	while( it.next() )
+	{
+		add( it.getItemset() ) ;
+
+		it.erase() ;
+	}
+
+	transv->deleteChildren() ;
+}
+
+/**
+*  close the file written by add()
+*/
+
+template< class Item >
+void ExternalTransversals< Item >::endSpill()
+{
+	if( writer.isOpen() )
+	{
+		writer.close() ;
+
+		check( writer, trName ) ;
+
+		nbItemsets = writer.getNbItemsets() ;
+		nbItems = writer.getNbItems() ;
+	}
+}
+
+/**
+*  the transversals can't be exact if a file is not
+*  completely written ( disk full ), so we stop
+*/
+
+template< class Item >
+void ExternalTransversals< Item >::check( ItemsetFileWriter< Item > & file, string & name )
+{
+	if( ! file.good() )
+	{
+		cerr << "can't write the transversals into " << name << endl;
+
+		exit( 1 ) ;
+	}
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that insert the next itemsets of reader into
+*  trie until their cost reach maxItems, at least one
+*  itemset is inserted if the file is not finished
+*/
+
+template< class Item >
+bool ExternalTransversals< Item >::loadBatch( ItemsetFileReader< Item > * reader, Trie< Item > * trie, unsigned long maxItems, int level )
+{
+	vector< Item > * vect ;
+
+	unsigned long cost = 0 ;
+
+	if( trie->getChildren() == 0 )
+		trie->makeChildren() ;
+
+	do
+	{
+		if( ! reader->next() )
+			return false ;
+
+		vect = reader->getItemset() ;
+
+		trie->insert( vect ) ;
+
+		// an itemset of Bi generates at most one candidate
+		// by item of the edge
+
+		cost += vect->size() + ( vect->size() + 1 ) * level ;
+	}
+	while( cost < maxItems ) ;
+
+	return true ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method generating the new transversals of the batch
+*  bi when Si is read by chunks from its file : the
+*  candidates are generated with the first chunk, then
+*  the candidates including an itemset of the next
+*  chunks are deleted
+*  an itemset of Bi has no item of the edge so a
+*  candidate has only one item of the edge, only the
+*  itemsets of Si including it are searched
+*/
+
+template< class Item >
+Trie< Item > * ExternalTransversals< Item >::newItTr( Trie< Item > * bi, vector< Item > * edge, SubsetIndex< Item > * freqTr, int nbThreads, unsigned long maxItems )
+{
+	ItemsetFileReader< Item > reader( siName.c_str() ) ;
+
+	Trie< Item > * chunk = new Trie< Item >( 0 ) ;
+
+	Trie< Item > * res = 0 ;
+
+	vector< Item > * vect ;
+
+	TrieIterator< Item > it ;
+
+	bool more ;
+
+	int mpos, e ;
+
+	do
+	{
+		more = loadBatch( &reader, chunk, maxItems, 0 ) ;
+
+		if( res == 0 )
+			res = chunk->newItTr( bi, edge, freqTr, nbThreads ) ;
+		else
+		{
+			it.reset( res ) ;
+
+			while( it.next() )
+			{
+				vect = it.getItemset() ;
+
+				// position of the item of the edge, the
+				// two itemsets are ordered
+
+				mpos = 0 ;
+				e = 0 ;
+
+				while( (*vect)[ mpos ] != (*edge)[ e ] )
+				{
+					if( (*vect)[ mpos ] < (*edge)[ e ] )
+						mpos++ ;
+					else
+						e++ ;
+				}
+
+				if( chunk->includedInWith( chunk->getChildren(), vect, mpos ) )
+				{
+					res->Decrement() ;
+
+					it.erase() ;
+				}
+			}
+		}
+
+		chunk->deleteChildren() ;
+	}
+	while( more && ( res->getSupport() != 0 ) ) ;
+
+	delete chunk ;
+
+	return res ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method which calcul the minimal transversal with i+1 edges
+*  from the minimal transversal with i edges and a new edge
+*  the transversals are read once to write Si and Bi ( see
+*  Trie::initTrBiOpt ), Si is also the beginning of the new
+*  transversals, then the new transversals are generated by
+*  batches of Bi ( see Trie::newItTr ) and appended to them
+*  Si is loaded once if it fits in half of the budget, else
+*  it is read by chunks for each batch
+*/
+
+template< class Item >
+void ExternalTransversals< Item >::addEdge( vector< Item > * edge, int n, int k, SubsetIndex< Item > * freqTr, int nbThreads )
+{
+	ItemsetFileReader< Item > reader ;
+
+	ItemsetFileWriter< Item > next( nextName.c_str() ) ;
+
+	ItemsetFileWriter< Item > siFile( siName.c_str() ) ;
+
+	ItemsetFileWriter< Item > biFile( biName.c_str() ) ;
+
+	Trie< Item > * si = 0 ;
+
+	Trie< Item > * bi ;
+
+	Trie< Item > * res ;
+
+	vector< Item > * vect ;
+
+	int level = edge->size() ;
+
+	Item * items = level ? &(*edge)[ 0 ] : 0 ;
+
+	unsigned long maxItems = budget / 2 / nodeBytes() ;
+
+	bool more ;
+
+	endSpill() ;
+
+	// construction of Si and Bi, the transversals
+	// of cardinality >= n-k are deleted
+
+	reader.open( trName.c_str() ) ;
+
+	while( reader.next() )
+	{
+		vect = reader.getItemset() ;
+
+		if( (int)vect->size() >= n-k )
+			continue ;
+
+		if( Trie< Item >::intersects( vect, items, level ) )
+		{
+			next.write( vect ) ;
+			siFile.write( vect ) ;
+		}
+		else if( (int)vect->size() < n-k-1 )
+			biFile.write( vect ) ;
+	}
+
+	reader.close() ;
+
+	siFile.close() ;
+	biFile.close() ;
+
+	check( siFile, siName ) ;
+	check( biFile, biName ) ;
+
+	if( siFile.getNbItems() <= maxItems )
+	{
+		si = new Trie< Item >( 0 ) ;
+
+		reader.open( siName.c_str() ) ;
+
+		loadBatch( &reader, si, siFile.getNbItems() + 1, 0 ) ;
+
+		reader.close() ;
+	}
+
+	// generation of the new transversals by batches of Bi
+
+	bi = new Trie< Item >( 0 ) ;
+
+	reader.open( biName.c_str() ) ;
+
+	do
+	{
+		more = loadBatch( &reader, bi, maxItems, level ) ;
+
+		if( bi->getSupport() == 0 )
+			break ;
+
+		if( si != 0 )
+			res = si->newItTr( bi, edge, freqTr, nbThreads ) ;
+		else
+			res = newItTr( bi, edge, freqTr, nbThreads, maxItems ) ;
+
+		TrieIterator< Item > it( res ) ;
+
+		while( it.next() )
+			next.write( it.getItemset() ) ;
+
+		delete res ;
+
+		bi->deleteChildren() ;
+	}
+	while( more ) ;
+
+	reader.close() ;
+
+	delete bi ;
+	delete si ;
+
+	next.close() ;
+
+	check( next, nextName ) ;
+
+	nbItemsets = next.getNbItemsets() ;
+	nbItems = next.getNbItems() ;
+
+	trName.swap( nextName ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method which replace the itemsets of transv by the
+*  minimal transversals
+*/
+
+template< class Item >
+void ExternalTransversals< Item >::toTrie( Trie< Item > * transv )
+{
+	ItemsetFileReader< Item > reader ;
+
+	endSpill() ;
+
+	transv->deleteChildren() ;
+
+	transv->makeChildren() ;
+
+	reader.open( trName.c_str() ) ;
+
+	while( reader.next() )
+		transv->insert( reader.getItemset() ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+// instantiation for the item identifiers on 8, 16 and 32 bits
+
+template class ExternalTransversals< unsigned char > ;
+template class ExternalTransversals< short unsigned > ;
+template class ExternalTransversals< unsigned int > ;
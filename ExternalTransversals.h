@@ -0,0 +1,142 @@
+/*----------------------------------------------------------------------
+  File    : ExternalTransversals.h
+  Contents: Class that calcul the minimal transversals of an hypergraph
+            with the incremental approach of Demetrovics et Thi when
+            they don't fit in the memory budget : the transversals are
+            kept in files ( see ItemsetFile ) and for each edge Si and
+            Bi are written in files and read back by batches, so only
+            a part of the transversals is loaded in tries at any time
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#ifndef EXTERNALTRANSVERSALS_H
+#define EXTERNALTRANSVERSALS_H
+
+#include "ItemsetFile.h"
+#include "SubsetIndex.h"
+
+template< class Item >
+class ExternalTransversals
+{
+protected:
+
+	// ------------------------------------------------
+	// names of the files of the transversals, of the
+	// transversals being built, of Si and of Bi
+	// ------------------------------------------------
+
+	string trName ;
+
+	string nextName ;
+
+	string siName ;
+
+	string biName ;
+
+	// ------------------------------------------------
+	// number of bytes that the tries may use, half of
+	// it for the itemsets of Si and half for a batch
+	// of Bi and its new transversals
+	// ------------------------------------------------
+
+	size_t budget ;
+
+	// ---------------------------------------------
+	// file being written while the transversals
+	// are given by add(), before the first edge
+	// ---------------------------------------------
+
+	ItemsetFileWriter< Item > writer ;
+
+	// ---------------------------------------------------
+	// number of transversals and of their items
+	// ---------------------------------------------------
+
+	unsigned long nbItemsets ;
+
+	unsigned long nbItems ;
+
+	bool created ;	// false if the first file can't be created
+
+	void endSpill() ;
+
+	void check( ItemsetFileWriter< Item > & file, string & name ) ;
+
+	// -----------------------------------------------------
+	// method that insert the next itemsets of reader into
+	// trie until their cost reach maxItems ( each itemset
+	// cost its size plus the size of its candidates if
+	// level is the size of the edge ), return false if
+	// the end of the file is reached
+	// -----------------------------------------------------
+
+	static bool loadBatch( ItemsetFileReader< Item > * reader, Trie< Item > * trie, unsigned long maxItems, int level ) ;
+
+	// -----------------------------------------------------
+	// method generating the new transversals of the
+	// batch bi when Si is read by chunks from its file
+	// -----------------------------------------------------
+
+	Trie< Item > * newItTr( Trie< Item > * bi, vector< Item > * edge, SubsetIndex< Item > * freqTr, int nbThreads, unsigned long maxItems ) ;
+
+public:
+
+	// -------------------------------------------------
+	// the files are created into the directory dir
+	// -------------------------------------------------
+
+	ExternalTransversals( const char * dir, size_t inBudget ) ;
+
+	~ExternalTransversals() ;
+
+	// ------------------------------------------------
+	// false if the file of the transversals can't be
+	// created
+	// ------------------------------------------------
+
+	bool good() const { return created ; }
+
+	// ------------------------------------------------
+	// methods giving the transversals before the first
+	// edge : one by one or all the itemsets of transv
+	// ( they are deleted from transv )
+	// ------------------------------------------------
+
+	void add( vector< Item > * itemset ) { writer.write( itemset ) ; }
+
+	void operator()( vector< Item > * itemset, unsigned int ) { add( itemset ) ; }
+
+	void spill( Trie< Item > * transv ) ;
+
+	// ----------------------------------------------------------
+	// method which calcul the minimal transversal with i+1 edges
+	// from the minimal transversal with i edges and a new edge
+	// ( same result as Trie::trMinIopt, freqTr is indexed )
+	// ----------------------------------------------------------
+
+	void addEdge( vector< Item > * edge, int n, int k, SubsetIndex< Item > * freqTr = 0, int nbThreads = 1 ) ;
+
+	unsigned int getSupport() const { return nbItemsets ; }
+
+	// ---------------------------------------------------
+	// method which replace the itemsets of transv by the
+	// minimal transversals
+	// ---------------------------------------------------
+
+	void toTrie( Trie< Item > * transv ) ;
+
+	// ------------------------------------------------
+	// estimation of the number of bytes used by a trie
+	// node, of the transversals if they were in a trie
+	// and of the trie transv
+	// ------------------------------------------------
+
+	static size_t nodeBytes() { return sizeof( Trie< Item > ) + 4 * sizeof( void * ) + sizeof( set< Trie< Item > > ) ; }
+
+	size_t memory() const { return nbItems * nodeBytes() ; }
+
+	static size_t memory( Trie< Item > * transv ) { return transv->countNodes() * nodeBytes() ; }
+
+};
+
+#endif
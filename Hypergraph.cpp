@@ -0,0 +1,536 @@
+/*----------------------------------------------------------------------
+  File    : Hypergraph.cpp
+  Contents: Class that store the edges of an hypergraph before their
+            dualisation. The edges that are supersets of another edge
+            can be removed and the edges can be ordered wrt an
+            heuristic before the incremental calculation of the
+            minimal transversals ( Demetrovics et Thi approach )
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "Hypergraph.h"
+#include "BitTransversals.h"
+#include "ExternalTransversals.h"
+#include "SubsetIndex.h"
+#include "TrieIterator.h"
+
+#include <algorithm>
+#include <sstream>
+
+/**
+*  method that copy an edge in the buffer
+*/
+
+template< class Item >
+vector< Item > * Hypergraph< Item >::getEdge( unsigned int num )
+{
+	edge.assign( items.begin() + edgeStart[ num ], items.begin() + edgeStart[ num + 1 ] ) ;
+
+	return &edge ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  methods adding edges to the hypergraph
+*/
+
+template< class Item >
+void Hypergraph< Item >::addEdge( vector< Item > * itemset )
+{
+	if( edgeStart.empty() )
+		edgeStart.push_back( 0 ) ;
+
+	order.push_back( edgeStart.size() - 1 ) ;
+
+	items.insert( items.end(), itemset->begin(), itemset->end() ) ;
+
+	edgeStart.push_back( items.size() ) ;
+}
+
+template< class Item >
+void Hypergraph< Item >::addEdges( Trie< Item > * edges )
+{
+	TrieIterator< Item > it( edges ) ;
+
+	while( it.next() )
+		addEdge( it.getItemset() ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that remove the edges including another
+*  edge, they don't change the minimal transversals
+*  return the number of edges removed
+*/
+
+template< class Item >
+unsigned int Hypergraph< Item >::minimise()
+{
+	Trie< Item > * kept = new Trie< Item >( 0 ) ;	// edges already kept
+
+	vector< unsigned int > bySize( order ) ;
+
+	vector< bool > removed( edgeStart.empty() ? 0 : edgeStart.size() - 1, false ) ;
+
+	vector< unsigned int > tmp ;
+
+	unsigned int nbRemoved = 0 ;
+
+	// an edge can only include smaller edges so
+	// they are tested by increasing size
+
+	stable_sort( bySize.begin(), bySize.end(), [ this ]( unsigned int a, unsigned int b ) 
+		{ return edgeStart[ a + 1 ] - edgeStart[ a ] < edgeStart[ b + 1 ] - edgeStart[ b ] ; } ) ;
+
+	kept->makeChildren() ;
+
+	for( unsigned int i = 0; i < bySize.size() ; i++ )
+	{
+		if( kept->includedIn( getEdge( bySize[ i ] ) ) )
+		{
+			removed[ bySize[ i ] ] = true ;
+			nbRemoved++ ;
+		}
+		else
+			kept->insert( &edge ) ;
+	}
+
+	delete kept ;
+
+	for( unsigned int i = 0; i < order.size() ; i++ )
+		if( ! removed[ order[ i ] ] )
+			tmp.push_back( order[ i ] ) ;
+
+	order.swap( tmp ) ;
+
+	return nbRemoved ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that order the edges wrt an heuristic
+*  ( the ties are kept in lexicographic order )
+*/
+
+template< class Item >
+void Hypergraph< Item >::sort( EdgeOrder inOrder )
+{
+	vector< unsigned int > degree ;	// number of edges of each item
+
+	vector< double > score ;		// average degree of the items of each edge
+
+	unsigned int num ;
+
+	// the edges are added in the order of a trie
+
+	std::sort( order.begin(), order.end() ) ;
+
+	if( inOrder == ORDER_SIZE )
+	{
+		stable_sort( order.begin(), order.end(), [ this ]( unsigned int a, unsigned int b ) 
+			{ return edgeStart[ a + 1 ] - edgeStart[ a ] < edgeStart[ b + 1 ] - edgeStart[ b ] ; } ) ;
+	}
+	else if( inOrder == ORDER_DEGREE )
+	{
+		for( unsigned int i = 0; i < order.size() ; i++ )
+			for( unsigned int j = edgeStart[ order[ i ] ]; j < edgeStart[ order[ i ] + 1 ] ; j++ )
+			{
+				if( items[ j ] >= degree.size() )
+					degree.resize( items[ j ] + 1, 0 ) ;
+
+				degree[ items[ j ] ]++ ;
+			}
+
+		score.assign( edgeStart.size() - 1, 0 ) ;
+
+		for( unsigned int i = 0; i < order.size() ; i++ )
+		{
+			num = order[ i ] ;
+
+			for( unsigned int j = edgeStart[ num ]; j < edgeStart[ num + 1 ] ; j++ )
+				score[ num ] += degree[ items[ j ] ] ;
+
+			if( edgeStart[ num + 1 ] != edgeStart[ num ] )
+				score[ num ] /= edgeStart[ num + 1 ] - edgeStart[ num ] ;
+		}
+
+		stable_sort( order.begin(), order.end(), [ &score ]( unsigned int a, unsigned int b ) 
+			{ return score[ a ] > score[ b ] ; } ) ;
+	}
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method which calcul the minimal transversal of the edges
+*  ( see Trie::trMinOpt ), nbThreads threads are used
+*/
+
+template< class Item >
+Trie< Item > * Hypergraph< Item >::trMinOpt( int n, int k, int nbThreads )
+{
+	Trie< Item > * res = new Trie< Item >( 0 ) ;
+
+	trMinIopt( res, n, k, 0, nbThreads ) ;
+
+	return res ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method which add the edges to the minimal transversals
+*  transv ( see Trie::trMinIopt ), nbThreads threads are used
+*  the number of minimal transversals after each edge is kept
+*  with a memory budget, the transversals are moved into files
+*  when they use more than half of it ( the other half is kept
+*  for the new transversals of the next edge ) and loaded back
+*  when they use less than a quarter of it
+*/
+
+template< class Item >
+void Hypergraph< Item >::trMinIopt( Trie< Item > * transv, int n, int k, Trie< Item > * freqTr, int nbThreads )
+{
+	ExternalTransversals< Item > * ext = 0 ;
+
+	SubsetIndex< Item > freqIndex ;
+
+	unsigned int first = 0 ;	// first edge added to the trie
+
+	sizes.clear() ;
+
+	nbSpilled = 0 ;
+
+	// the internal ids of the items are between 0 and n-1,
+	// the smallest bit vectors that store them are used
+
+	if( bitsets && ( order.size() != 0 ) && BitTransversals< Item, 8 >::fits( n ) )
+	{
+		if( BitTransversals< Item, 1 >::fits( n ) )
+			first = bitTrMinIopt< 1 >( transv, n, k, freqTr, ext ) ;
+		else if( BitTransversals< Item, 2 >::fits( n ) )
+			first = bitTrMinIopt< 2 >( transv, n, k, freqTr, ext ) ;
+		else if( BitTransversals< Item, 4 >::fits( n ) )
+			first = bitTrMinIopt< 4 >( transv, n, k, freqTr, ext ) ;
+		else
+			first = bitTrMinIopt< 8 >( transv, n, k, freqTr, ext ) ;
+	}
+
+	// the index of freqTr is built once for all the edges
+
+	if( first < order.size() )
+		freqIndex.build( freqTr ) ;
+
+	for( unsigned int i = first; i < order.size() ; i++ )
+	{
+		if( ( ext == 0 ) && ( memoryBudget != 0 ) && ( transv->getChildren() != 0 )
+			&& ( ExternalTransversals< Item >::memory( transv ) > memoryBudget / 2 ) )
+		{
+			ext = createExternal() ;
+
+			if( ext != 0 )
+				ext->spill( transv ) ;
+		}
+
+		if( ext != 0 )
+		{
+			ext->addEdge( getEdge( order[ i ] ), n, k, &freqIndex, nbThreads ) ;
+
+			nbSpilled++ ;
+
+			sizes.push_back( ext->getSupport() ) ;
+
+			if( ext->memory() <= memoryBudget / 4 )
+			{
+				ext->toTrie( transv ) ;
+
+				delete ext ;
+
+				ext = 0 ;
+			}
+
+			continue ;
+		}
+
+		if ( transv->getChildren() == 0 )
+			transv->initTr( getEdge( order[ i ] ) ) ;
+		else
+			transv->trMinIopt( getEdge( order[ i ] ), n, k, &freqIndex, nbThreads ) ;
+
+		sizes.push_back( transv->getSupport() ) ;
+	}
+
+	if( ext != 0 )
+	{
+		ext->toTrie( transv ) ;
+
+		delete ext ;
+	}
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  same method with the transversals stored in bit vectors
+*  of W words during the dualisation, with a memory budget
+*  they are given to ext when they use more than half of it
+*  and the next edges are added to the files
+*/
+
+template< class Item >
+template< int W >
+unsigned int Hypergraph< Item >::bitTrMinIopt( Trie< Item > * transv, int n, int k, Trie< Item > * freqTr, ExternalTransversals< Item > * & ext )
+{
+	BitTransversals< Item, W > bits( transv, freqTr ) ;
+
+	unsigned int i = 0 ;
+
+	// the transversals are in the bit vectors
+
+	transv->deleteChildren() ;
+
+	while( i < order.size() )
+	{
+		bits.addEdge( getEdge( order[ i ] ), n, k ) ;
+
+		sizes.push_back( bits.getSupport() ) ;
+
+		i++ ;
+
+		if( ( memoryBudget != 0 ) && ( i < order.size() ) && ( bits.memory() > memoryBudget / 2 ) )
+		{
+			ext = createExternal() ;
+
+			if( ext != 0 )
+			{
+				bits.visitItemsets( *ext ) ;
+
+				return i ;
+			}
+		}
+	}
+
+	bits.toTrie( transv ) ;
+
+	return i ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method creating the files of the transversals, if they
+*  can't be created the dualisation goes on in memory
+*/
+
+template< class Item >
+ExternalTransversals< Item > * Hypergraph< Item >::createExternal()
+{
+	ExternalTransversals< Item > * ext = new ExternalTransversals< Item >( spillDir.c_str(), memoryBudget ) ;
+
+	if( ext->good() )
+		return ext ;
+
+	cerr << "can't create the files of the transversals in " << spillDir << endl;
+
+	delete ext ;
+
+	memoryBudget = 0 ;
+
+	return 0 ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  functor writing an itemset on a line
+*/
+
+template< class Item >
+struct EdgeWriter
+{
+	ofstream & pFile ;
+
+	EdgeWriter( ofstream & inFile ) : pFile( inFile ) {}
+
+	void operator()( vector< Item > * itemset, unsigned int )
+	{
+		for( unsigned int j = 0; j < itemset->size() ; j++ )
+			pFile<< ( j ? " " : "" ) << (unsigned int)(*itemset)[ j ] ;
+
+		pFile<<endl;
+	}
+};
+
+/**
+*  write a section : its name, the number of itemsets
+*  and the itemsets of trie ( none if trie is 0 )
+*/
+
+template< class Item >
+static void saveSection( ofstream & pFile, const char * name, Trie< Item > * trie )
+{
+	EdgeWriter< Item > writer( pFile ) ;
+
+	TrieIterator< Item > it( trie ) ;
+
+	pFile<< name <<" "<< ( trie ? trie->getSupport() : 0 ) <<endl;
+
+	if( trie != 0 )
+		while( it.next() )
+			writer( it.getItemset(), 0 ) ;
+}
+
+/**
+*  methods saving into a text file the edges and the
+*  parameters of a dualisation, and appending the
+*  transversals found
+*/
+
+template< class Item >
+bool Hypergraph< Item >::save( const char * fileName, int n, int k, Trie< Item > * transv, Trie< Item > * freqTr )
+{
+	ofstream pFile( fileName ) ;
+
+	EdgeWriter< Item > writer( pFile ) ;
+
+	if( ! pFile.is_open() )
+		return false ;
+
+	pFile<<"dualisation "<< n <<" "<< k <<endl;
+
+	pFile<<"edges "<< order.size() <<endl;
+
+	visitEdges( writer ) ;
+
+	saveSection( pFile, "transversals", transv ) ;
+	saveSection( pFile, "freqTr", freqTr ) ;
+
+	return pFile.good() ;
+}
+
+template< class Item >
+bool Hypergraph< Item >::saveResult( const char * fileName, Trie< Item > * res )
+{
+	ofstream pFile( fileName, ios::app ) ;
+
+	if( ! pFile.is_open() )
+		return false ;
+
+	saveSection( pFile, "result", res ) ;
+
+	return pFile.good() ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that add the edges of a file to this
+*  hypergraph and read the parameters
+*/
+
+template< class Item >
+bool Hypergraph< Item >::load( const char * fileName, int & n, int & k, Trie< Item > * transv, Trie< Item > * freqTr, Trie< Item > * res )
+{
+	ifstream pFile( fileName ) ;
+
+	string line, name ;
+
+	vector< Item > itemset ;
+
+	unsigned int item ;
+
+	unsigned long count ;
+
+	Trie< Item > * trie ;
+
+	if( ! pFile.is_open() || ! getline( pFile, line ) )
+		return false ;
+
+	istringstream header( line ) ;
+
+	if( ! ( header >> name >> n >> k ) || ( name != "dualisation" ) )
+		return false ;
+
+	while( getline( pFile, line ) )
+	{
+		istringstream section( line ) ;
+
+		if( ! ( section >> name >> count ) )
+			return false ;
+
+		if( name == "edges" )
+			trie = 0 ;
+		else if( name == "transversals" )
+			trie = transv ;
+		else if( name == "freqTr" )
+			trie = freqTr ;
+		else if( name == "result" )
+			trie = res ;
+		else
+			return false ;
+
+		// an empty set is left without children, as the
+		// transversals before the first edge
+
+		if( ( trie != 0 ) && ( count != 0 ) )
+			trie->makeChildren() ;
+
+		for( unsigned long i = 0; i < count ; i++ )
+		{
+			if( ! getline( pFile, line ) )
+				return false ;
+
+			istringstream in( line ) ;
+
+			itemset.clear() ;
+
+			while( in >> item )
+				itemset.push_back( item ) ;
+
+			if( trie == 0 )
+			{
+				if( name == "edges" )
+					addEdge( &itemset ) ;
+			}
+			else
+				trie->insert( &itemset ) ;
+		}
+	}
+
+	return true ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  greatest and total number of minimal transversals
+*  during the last dualisation
+*/
+
+template< class Item >
+unsigned int Hypergraph< Item >::getMaxSize() const
+{
+	return sizes.empty() ? 0 : *max_element( sizes.begin(), sizes.end() ) ;
+}
+
+template< class Item >
+unsigned long Hypergraph< Item >::getSumSizes() const
+{
+	unsigned long sum = 0 ;
+
+	for( unsigned int i = 0; i < sizes.size() ; i++ )
+		sum += sizes[ i ] ;
+
+	return sum ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+// instantiation for the item identifiers on 8, 16 and 32 bits
+
+template class Hypergraph< unsigned char > ;
+template class Hypergraph< short unsigned > ;
+template class Hypergraph< unsigned int > ;
@@ -0,0 +1,206 @@
+/*----------------------------------------------------------------------
+  File    : Hypergraph.h
+  Contents: Class that store the edges of an hypergraph before their
+            dualisation. The edges that are supersets of another edge
+            can be removed and the edges can be ordered wrt an
+            heuristic before the incremental calculation of the
+            minimal transversals ( Demetrovics et Thi approach )
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#ifndef HYPERGRAPH_H
+#define HYPERGRAPH_H
+
+#include "Trie.h"
+
+#include <string>
+
+template< class Item > class ExternalTransversals ;
+
+// ------------------------------------------------------
+// order of the edges during the dualisation :
+//   ORDER_LEX    : lexicographic order ( order of a trie )
+//   ORDER_SIZE   : smallest edges first
+//   ORDER_DEGREE : edges whose items are in the most
+//                  edges first
+// ------------------------------------------------------
+
+enum EdgeOrder { ORDER_LEX, ORDER_SIZE, ORDER_DEGREE } ;
+
+template< class Item >
+class Hypergraph
+{
+protected:
+
+	// ------------------------------------------------
+	// items of the edges, stored one edge after the
+	// other, and position of the first item of each
+	// edge ( the last value is the end of the last edge )
+	// ------------------------------------------------
+
+	vector< Item > items ;
+
+	vector< unsigned int > edgeStart ;
+
+	// -------------------------------------
+	// numbers of the edges in their order
+	// -------------------------------------
+
+	vector< unsigned int > order ;
+
+	// --------------------------------------------
+	// number of minimal transversals after each
+	// edge during the last dualisation
+	// --------------------------------------------
+
+	vector< unsigned int > sizes ;
+
+	vector< Item > edge ;	// buffer of the current edge
+
+	// ---------------------------------------------
+	// true if the transversals are calculated with
+	// bit vectors when the items fit in 512 bits
+	// ---------------------------------------------
+
+	bool bitsets ;
+
+	// ------------------------------------------------
+	// number of bytes that the transversals may use
+	// ( 0 for no limit ), directory of the files where
+	// they are kept beyond it, and number of edges
+	// added to the transversals kept in files during
+	// the last dualisation
+	// ------------------------------------------------
+
+	size_t memoryBudget ;
+
+	string spillDir ;
+
+	unsigned int nbSpilled ;
+
+	vector< Item > * getEdge( unsigned int num ) ;
+
+	ExternalTransversals< Item > * createExternal() ;
+
+	// --------------------------------------------------
+	// method adding the edges to the transversals stored
+	// in bit vectors, return the number of edges added
+	// ( less than all if ext receives the transversals )
+	// --------------------------------------------------
+
+	template< int W >
+	unsigned int bitTrMinIopt( Trie< Item > * transv, int n, int k, Trie< Item > * freqTr, ExternalTransversals< Item > * & ext ) ;
+
+public:
+
+	Hypergraph() : bitsets( false ), memoryBudget( 0 ), nbSpilled( 0 ) {}
+
+	Hypergraph( Trie< Item > * edges ) : bitsets( false ), memoryBudget( 0 ), nbSpilled( 0 ) { addEdges( edges ) ; }
+
+	void setBitsets( bool inBitsets ) { bitsets = inBitsets ; }
+
+	// ------------------------------------------------
+	// method that limit the memory of the transversals
+	// during the dualisation, beyond half of inBudget
+	// bytes they are kept in files of the directory
+	// inDir ( see ExternalTransversals )
+	// ------------------------------------------------
+
+	void setMemoryBudget( size_t inBudget, const char * inDir ) { memoryBudget = inBudget ; spillDir = inDir ; }
+
+	// -----------------------------------------------
+	// methods adding edges to the hypergraph
+	// ( in the order of the trie )
+	// -----------------------------------------------
+
+	void addEdge( vector< Item > * itemset ) ;
+
+	void addEdges( Trie< Item > * edges ) ;
+
+	unsigned int getNbEdges() const { return order.size() ; }
+
+	// --------------------------------------------------
+	// method applying a visitor to all the edges in
+	// their order :   visitor( edge, 0 )
+	// --------------------------------------------------
+
+	template< class Visitor >
+	void visitEdges( Visitor & visitor ) ;
+
+	// ------------------------------------------------
+	// method that remove the edges including another
+	// edge, they don't change the minimal transversals
+	// return the number of edges removed
+	// ------------------------------------------------
+
+	unsigned int minimise() ;
+
+	// ------------------------------------------------
+	// method that order the edges wrt an heuristic
+	// ( the ties are kept in lexicographic order )
+	// ------------------------------------------------
+
+	void sort( EdgeOrder inOrder ) ;
+
+	// -------------------------------------------------------------
+	// method which calcul the minimal transversal of the edges
+	// ( see Trie::trMinOpt ), nbThreads threads are used
+	// -------------------------------------------------------------
+
+	Trie< Item > * trMinOpt( int n, int k, int nbThreads = 1 ) ;
+
+	// -------------------------------------------------------------
+	// method which add the edges to the minimal transversals
+	// transv ( see Trie::trMinIopt ), nbThreads threads are used
+	// ( the bit vectors are only used by one thread )
+	// -------------------------------------------------------------
+
+	void trMinIopt( Trie< Item > * transv, int n, int k, Trie< Item > * freqTr = 0, int nbThreads = 1 ) ;
+
+	// ------------------------------------------------
+	// number of minimal transversals after each edge
+	// during the last dualisation
+	// ------------------------------------------------
+
+	vector< unsigned int > * getSizes() { return &sizes ; }
+
+	unsigned int getMaxSize() const ;
+
+	unsigned long getSumSizes() const ;
+
+	unsigned int getNbSpilled() const { return nbSpilled ; }
+
+	// ----------------------------------------------------
+	// methods saving into a text file the edges and the
+	// parameters of a dualisation : n, k, the transversals
+	// and freqTr given to trMinIopt ( 0 for trMinOpt ) and
+	// appending the transversals found, one section by set
+	// of itemsets, each itemset on a line
+	// ----------------------------------------------------
+
+	bool save( const char * fileName, int n, int k, Trie< Item > * transv = 0, Trie< Item > * freqTr = 0 ) ;
+
+	static bool saveResult( const char * fileName, Trie< Item > * res ) ;
+
+	// ----------------------------------------------------
+	// method that add the edges of a file to this
+	// hypergraph and read the parameters, the sets of
+	// itemsets missing in the file are left empty
+	// ( res is 0 or receives the transversals found )
+	// ----------------------------------------------------
+
+	bool load( const char * fileName, int & n, int & k, Trie< Item > * transv, Trie< Item > * freqTr, Trie< Item > * res = 0 ) ;
+
+};
+
+// ----------------------------------------------------------------------------------------------
+
+template< class Item >
+template< class Visitor >
+void Hypergraph< Item >::visitEdges( Visitor & visitor )
+{
+	for( unsigned int i = 0; i < order.size() ; i++ )
+		visitor( getEdge( order[ i ] ), 0 ) ;
+}
+
+#endif
@@ -0,0 +1,179 @@
+/*----------------------------------------------------------------------
+  File    : ItemsetFile.cpp
+  Contents: Classes that write and read sets of itemsets in a compact
+            binary file : each itemset is stored as the number of
+            items shared with the previous itemset, the number of the
+            other items and these items, all the numbers are coded
+            on a variable number of bytes ( 7 bits by byte ). The
+            itemsets written in the order of a trie share their
+            prefix, so a file is much smaller than the itemsets
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "ItemsetFile.h"
+
+/**
+*  method that create ( or truncate ) the file,
+*  return false if the file can't be opened
+*/
+
+template< class Item >
+bool ItemsetFileWriter< Item >::open( const char * fileName )
+{
+	close() ;
+
+	pFile.clear() ;
+
+	pFile.open( fileName, ios::out | ios::binary | ios::trunc ) ;
+
+	previous.clear() ;
+
+	nbItemsets = 0 ;
+	nbItems = 0 ;
+
+	return pFile.is_open() ;
+}
+
+template< class Item >
+void ItemsetFileWriter< Item >::close()
+{
+	if( pFile.is_open() )
+		pFile.close() ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  write a number on as many bytes as needed, 7 bits
+*  by byte, the high bit is set on all the bytes
+*  except the last one
+*/
+
+template< class Item >
+void ItemsetFileWriter< Item >::writeNumber( unsigned long number )
+{
+	while( number >= 0x80 )
+	{
+		pFile.put( (char)( ( number & 0x7F ) | 0x80 ) ) ;
+
+		number >>= 7 ;
+	}
+
+	pFile.put( (char)number ) ;
+}
+
+/**
+*  method that append an itemset to the file,
+*  only the items after the prefix shared with
+*  the previous itemset are written
+*/
+
+template< class Item >
+void ItemsetFileWriter< Item >::write( vector< Item > * itemset )
+{
+	unsigned int prefix = 0 ;
+
+	while( ( prefix < previous.size() ) && ( prefix < itemset->size() ) && ( previous[ prefix ] == (*itemset)[ prefix ] ) )
+		prefix++ ;
+
+	writeNumber( prefix ) ;
+	writeNumber( itemset->size() - prefix ) ;
+
+	for( unsigned int i = prefix; i < itemset->size() ; i++ )
+		writeNumber( (*itemset)[ i ] ) ;
+
+	previous = *itemset ;
+
+	nbItemsets++ ;
+	nbItems += itemset->size() ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+template< class Item >
+bool ItemsetFileReader< Item >::open( const char * fileName )
+{
+	close() ;
+
+	pFile.clear() ;
+
+	pFile.open( fileName, ios::in | ios::binary ) ;
+
+	itemset.clear() ;
+
+	return pFile.is_open() ;
+}
+
+template< class Item >
+void ItemsetFileReader< Item >::close()
+{
+	if( pFile.is_open() )
+		pFile.close() ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  read a number written by ItemsetFileWriter::writeNumber,
+*  return false at the end of the file
+*/
+
+template< class Item >
+bool ItemsetFileReader< Item >::readNumber( unsigned long & number )
+{
+	int byte ;
+
+	int shift = 0 ;
+
+	number = 0 ;
+
+	while( ( byte = pFile.get() ) != EOF )
+	{
+		number |= (unsigned long)( byte & 0x7F ) << shift ;
+
+		if( ( byte & 0x80 ) == 0 )
+			return true ;
+
+		shift += 7 ;
+	}
+
+	return false ;
+}
+
+/**
+*  method that read the next itemset, the prefix
+*  shared with the previous itemset is kept
+*/
+
+template< class Item >
+bool ItemsetFileReader< Item >::next()
+{
+	unsigned long prefix, size, item ;
+
+	if( ! pFile.is_open() || ! readNumber( prefix ) || ! readNumber( size ) )
+		return false ;
+
+	itemset.resize( prefix ) ;
+
+	for( unsigned long i = 0; i < size ; i++ )
+	{
+		if( ! readNumber( item ) )
+			return false ;
+
+		itemset.push_back( (Item)item ) ;
+	}
+
+	return true ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+// instantiation for the item identifiers on 8, 16 and 32 bits
+
+template class ItemsetFileWriter< unsigned char > ;
+template class ItemsetFileWriter< short unsigned > ;
+template class ItemsetFileWriter< unsigned int > ;
+
+template class ItemsetFileReader< unsigned char > ;
+template class ItemsetFileReader< short unsigned > ;
+template class ItemsetFileReader< unsigned int > ;
@@ -0,0 +1,116 @@
+/*----------------------------------------------------------------------
+  File    : ItemsetFile.h
+  Contents: Classes that write and read sets of itemsets in a compact
+            binary file : each itemset is stored as the number of
+            items shared with the previous itemset, the number of the
+            other items and these items, all the numbers are coded
+            on a variable number of bytes ( 7 bits by byte ). The
+            itemsets written in the order of a trie share their
+            prefix, so a file is much smaller than the itemsets
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#ifndef ITEMSETFILE_H
+#define ITEMSETFILE_H
+
+#include "Trie.h"
+
+#include <string>
+
+template< class Item >
+class ItemsetFileWriter
+{
+protected:
+
+	ofstream pFile ;
+
+	vector< Item > previous ;	// last itemset written
+
+	// ---------------------------------------------
+	// number of itemsets and of items written
+	// ( the items of the prefixes are counted )
+	// ---------------------------------------------
+
+	unsigned long nbItemsets ;
+
+	unsigned long nbItems ;
+
+	void writeNumber( unsigned long number ) ;
+
+public:
+
+	ItemsetFileWriter() : nbItemsets( 0 ), nbItems( 0 ) {}
+
+	ItemsetFileWriter( const char * fileName ) : nbItemsets( 0 ), nbItems( 0 ) { open( fileName ) ; }
+
+	// ------------------------------------------------
+	// method that create ( or truncate ) the file,
+	// return false if the file can't be opened
+	// ------------------------------------------------
+
+	bool open( const char * fileName ) ;
+
+	bool isOpen() const { return pFile.is_open() ; }
+
+	void close() ;
+
+	// ---------------------------------------------
+	// method that append an itemset to the file
+	// ( the items MUST BE ordered )
+	// ---------------------------------------------
+
+	void write( vector< Item > * itemset ) ;
+
+	void operator()( vector< Item > * itemset, unsigned int ) { write( itemset ) ; }
+
+	// ---------------------------------
+	// method returning the attributes
+	// ---------------------------------
+
+	unsigned long getNbItemsets() const { return nbItemsets ; }
+
+	unsigned long getNbItems() const { return nbItems ; }
+
+	// ------------------------------------------
+	// false if a write has failed ( disk full )
+	// ------------------------------------------
+
+	bool good() const { return ! pFile.fail() ; }
+
+};
+
+template< class Item >
+class ItemsetFileReader
+{
+protected:
+
+	ifstream pFile ;
+
+	vector< Item > itemset ;	// current itemset
+
+	bool readNumber( unsigned long & number ) ;
+
+public:
+
+	ItemsetFileReader() {}
+
+	ItemsetFileReader( const char * fileName ) { open( fileName ) ; }
+
+	bool open( const char * fileName ) ;
+
+	bool isOpen() const { return pFile.is_open() ; }
+
+	void close() ;
+
+	// ------------------------------------------------
+	// method that read the next itemset, return false
+	// at the end of the file
+	// ------------------------------------------------
+
+	bool next() ;
+
+	vector< Item > * getItemset() { return &itemset ; }
+
+};
+
+#endif
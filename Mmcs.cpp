@@ -0,0 +1,343 @@
+/*----------------------------------------------------------------------
+  File    : Mmcs.cpp
+  Contents: Class that calcul the minimal transversals of an hypergraph
+            with the depth first enumeration MMCS of Murakami et Uno.
+            It is an alternative to the incremental approach of
+            Demetrovics et Thi implemented in Trie : the edges are
+            accumulated and the minimal transversals are enumerated
+            from scratch without storing intermediate transversals
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "Mmcs.h"
+#include "TrieIterator.h"
+
+#include <algorithm>
+
+/**
+*  method adding an edge to the hypergraph
+*/
+
+template< class Item >
+void Mmcs< Item >::addEdge( vector< Item > * edge )
+{
+	unsigned int num ;
+
+	if( edgeStart.empty() )
+		edgeStart.push_back( 0 ) ;
+
+	num = edgeStart.size() - 1 ;
+
+	for( int i = 0; i < edge->size() ; i++ )
+	{
+		if( (*edge)[ i ] >= occurrences.size() )
+			occurrences.resize( (*edge)[ i ] + 1 ) ;
+
+		occurrences[ (*edge)[ i ] ].push_back( num ) ;
+
+		items.push_back( (*edge)[ i ] ) ;
+	}
+
+	edgeStart.push_back( items.size() ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method adding all the itemsets of a trie as edges
+*/
+
+template< class Item >
+void Mmcs< Item >::addEdges( Trie< Item > * edges )
+{
+	TrieIterator< Item > it( edges ) ;
+
+	while( it.next() )
+		addEdge( it.getItemset() ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  functor adding the itemsets of a compact trie or the
+*  edges of an hypergraph as edges
+*/
+
+template< class Item >
+struct EdgeCollector
+{
+	Mmcs< Item > * hyper ;
+
+	EdgeCollector( Mmcs< Item > * inHyper ) : hyper( inHyper ) {}
+
+	void operator()( vector< Item > * edge, unsigned int )
+	{
+		hyper->addEdge( edge ) ;
+	}
+};
+
+template< class Item >
+void Mmcs< Item >::addEdges( CompactTrie< Item > * edges )
+{
+	EdgeCollector< Item > collector( this ) ;
+
+	edges->visitItemsets( collector ) ;
+}
+
+template< class Item >
+void Mmcs< Item >::addEdges( Hypergraph< Item > * edges )
+{
+	EdgeCollector< Item > collector( this ) ;
+
+	edges->visitEdges( collector ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  methods updating the set of edges not hit
+*  by the current itemset
+*/
+
+template< class Item >
+void Mmcs< Item >::removeUncovered( unsigned int edge )
+{
+	unsigned int last = uncovered.back() ;
+
+	uncovered[ uncovPos[ edge ] ] = last ;
+	uncovPos[ last ] = uncovPos[ edge ] ;
+
+	uncovered.pop_back() ;
+}
+
+template< class Item >
+void Mmcs< Item >::addUncovered( unsigned int edge )
+{
+	uncovPos[ edge ] = uncovered.size() ;
+
+	uncovered.push_back( edge ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that add an item to the current itemset,
+*  return false if an item of the current itemset
+*  has no more critical edge ( ie not minimal )
+*/
+
+template< class Item >
+bool Mmcs< Item >::addItem( Item item )
+{
+	bool minimal = true ;
+
+	vector< unsigned int > & occ = occurrences[ item ] ;
+
+	for( int i = 0; i < occ.size() ; i++ )
+	{
+		if( hits[ occ[ i ] ] == 0 )
+		{
+			// item is the only item of the itemset in this edge
+
+			removeUncovered( occ[ i ] ) ;
+
+			owner[ occ[ i ] ] = item ;
+
+			critical[ item ]++ ;
+		}
+		else if( hits[ occ[ i ] ] == 1 )
+		{
+			// this edge is no more critical for its owner
+
+			if( --critical[ owner[ occ[ i ] ] ] == 0 )
+				minimal = false ;
+		}
+
+		hits[ occ[ i ] ]++ ;
+	}
+
+	current.push_back( item ) ;
+
+	return minimal ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that remove the last item added to the
+*  current itemset
+*/
+
+template< class Item >
+void Mmcs< Item >::removeItem( Item item )
+{
+	vector< unsigned int > & occ = occurrences[ item ] ;
+
+	current.pop_back() ;
+
+	for( int i = 0; i < occ.size() ; i++ )
+	{
+		hits[ occ[ i ] ]-- ;
+
+		if( hits[ occ[ i ] ] == 0 )
+		{
+			addUncovered( occ[ i ] ) ;
+
+			critical[ item ]-- ;
+		}
+		else if( hits[ occ[ i ] ] == 1 )
+			critical[ owner[ occ[ i ] ] ]++ ;
+	}
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method enumerating the minimal transversals that
+*  extend the current itemset with candidate items
+*/
+
+template< class Item >
+void Mmcs< Item >::search()
+{
+	int best = -1 ;			// uncovered edge with the fewest candidates
+
+	unsigned int bestCnt = 0 ;
+
+	unsigned int cnt ;
+
+	vector< Item > cand ;	// candidates of the chosen edge
+
+	if( uncovered.empty() )
+	{
+		// the current itemset is a minimal transversal
+
+		sorted.assign( current.begin(), current.end() ) ;
+
+		sort( sorted.begin(), sorted.end() ) ;
+
+		res->insert( &sorted ) ;
+
+		return ;
+	}
+
+	if( (int)current.size() >= maxSize )
+		return ;
+
+	for( int i = 0; i < uncovered.size() ; i++ )
+	{
+		cnt = 0 ;
+
+		for( unsigned int j = edgeStart[ uncovered[ i ] ]; j < edgeStart[ uncovered[ i ] + 1 ] ; j++ )
+			if( candidates[ items[ j ] ] )
+				cnt++ ;
+
+		// this edge can't be hit anymore
+
+		if( cnt == 0 )
+			return ;
+
+		if( ( best == -1 ) || ( cnt < bestCnt ) )
+		{
+			best = uncovered[ i ] ;
+			bestCnt = cnt ;
+		}
+	}
+
+	for( unsigned int j = edgeStart[ best ]; j < edgeStart[ best + 1 ] ; j++ )
+		if( candidates[ items[ j ] ] )
+		{
+			cand.push_back( items[ j ] ) ;
+
+			candidates[ items[ j ] ] = false ;
+		}
+
+	for( int i = 0; i < cand.size() ; i++ )
+	{
+		if( addItem( cand[ i ] ) )
+		{
+			// the transversals including an itemset
+			// of freqTr are not generated
+
+			if( freqTr != 0 )
+			{
+				sorted.assign( current.begin(), current.end() ) ;
+
+				sort( sorted.begin(), sorted.end() ) ;
+			}
+
+			if( ( freqTr == 0 ) || ( freqTr->includedIn( &sorted ) == false ) )
+				search() ;
+		}
+
+		removeItem( cand[ i ] ) ;
+
+		// the next transversals can use this item
+
+		candidates[ cand[ i ] ] = true ;
+	}
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method which calcul the minimal transversal of the edges
+*  this method is optimised for our problem since it doesn't
+*  generate the transversal of cardinality >= n-k
+*                        with n the number of items and
+*                             k the actual level of the
+*								levelwise approach
+*  and the transversals including an itemset of freqTr
+*/
+
+template< class Item >
+Trie< Item > * Mmcs< Item >::trMinOpt( int n, int k, Trie< Item > * inFreqTr )
+{
+	unsigned int nbEdges = getNbEdges() ;
+
+	Trie< Item > * tr = new Trie< Item >( 0 ) ;
+
+	if( nbEdges == 0 )
+		return tr ;
+
+	res = tr ;
+
+	maxSize = n - k - 1 ;
+
+	if( ( inFreqTr != 0 ) && ( inFreqTr->getChildren() != 0 ) && ( ! inFreqTr->getChildren()->empty() ) )
+		freqTr = inFreqTr ;
+	else
+		freqTr = 0 ;
+
+	current.clear() ;
+
+	candidates.assign( occurrences.size(), true ) ;
+	critical.assign( occurrences.size(), 0 ) ;
+
+	hits.assign( nbEdges, 0 ) ;
+	owner.assign( nbEdges, 0 ) ;
+
+	uncovered.resize( nbEdges ) ;
+	uncovPos.resize( nbEdges ) ;
+
+	for( unsigned int e = 0; e < nbEdges ; e++ )
+	{
+		uncovered[ e ] = e ;
+		uncovPos[ e ] = e ;
+	}
+
+	search() ;
+
+	res = 0 ;
+	freqTr = 0 ;
+
+	return tr ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+// instantiation for the item identifiers on 8, 16 and 32 bits
+
+template class Mmcs< unsigned char > ;
+template class Mmcs< short unsigned > ;
+template class Mmcs< unsigned int > ;
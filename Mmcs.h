@@ -0,0 +1,136 @@
+/*----------------------------------------------------------------------
+  File    : Mmcs.h
+  Contents: Class that calcul the minimal transversals of an hypergraph
+            with the depth first enumeration MMCS of Murakami et Uno.
+            It is an alternative to the incremental approach of
+            Demetrovics et Thi implemented in Trie : the edges are
+            accumulated and the minimal transversals are enumerated
+            from scratch without storing intermediate transversals
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#ifndef MMCS_H
+#define MMCS_H
+
+#include "CompactTrie.h"
+#include "Hypergraph.h"
+
+template< class Item >
+class Mmcs
+{
+protected:
+
+	// ------------------------------------------------
+	// items of the edges of the hypergraph, stored
+	// one edge after the other
+	// ------------------------------------------------
+
+	vector< Item > items ;
+
+	// ------------------------------------------------
+	// position of the first item of each edge in items
+	// ( the last value is the end of the last edge )
+	// ------------------------------------------------
+
+	vector< unsigned int > edgeStart ;
+
+	// -----------------------------------
+	// number of the edges of each item
+	// -----------------------------------
+
+	vector< vector< unsigned int > > occurrences ;
+
+	// ------------------------------------------------
+	// state of the enumeration : the current itemset,
+	// the candidate items, and for each edge the
+	// number of items of the current itemset in it
+	// and the first of these items
+	// ------------------------------------------------
+
+	vector< Item > current ;
+
+	vector< bool > candidates ;
+
+	vector< unsigned int > hits ;
+
+	vector< Item > owner ;
+
+	// --------------------------------------------------
+	// number of edges for which an item is the only item
+	// of the current itemset ( critical edges )
+	// --------------------------------------------------
+
+	vector< unsigned int > critical ;
+
+	// --------------------------------------------
+	// edges not hit by the current itemset and
+	// position of each edge in this vector
+	// --------------------------------------------
+
+	vector< unsigned int > uncovered ;
+
+	vector< unsigned int > uncovPos ;
+
+	// -------------------------------------------
+	// maximal cardinality of the transversals,
+	// transversals to skip and result
+	// -------------------------------------------
+
+	int maxSize ;
+
+	Trie< Item > * freqTr ;
+
+	Trie< Item > * res ;
+
+	vector< Item > sorted ;
+
+	void removeUncovered( unsigned int edge ) ;
+
+	void addUncovered( unsigned int edge ) ;
+
+	// --------------------------------------------------
+	// method that add an item to the current itemset,
+	// return false if an item of the current itemset
+	// has no more critical edge ( ie not minimal )
+	// --------------------------------------------------
+
+	bool addItem( Item item ) ;
+
+	void removeItem( Item item ) ;
+
+	void search() ;
+
+public:
+
+	Mmcs() : maxSize( 0 ), freqTr( 0 ), res( 0 ) {}
+
+	// -----------------------------------------------
+	// methods adding edges to the hypergraph
+	// -----------------------------------------------
+
+	void addEdge( vector< Item > * edge ) ;
+
+	void addEdges( Trie< Item > * edges ) ;
+
+	void addEdges( CompactTrie< Item > * edges ) ;
+
+	void addEdges( Hypergraph< Item > * edges ) ;
+
+	unsigned int getNbEdges() const { return edgeStart.empty() ? 0 : edgeStart.size() - 1 ; }
+
+	// -------------------------------------------------------------
+	// method which calcul the minimal transversal of the edges
+	// this method is optimised for our problem since it doesn't
+	// generate the transversal of cardinality >= n-k
+	//                        with n the number of items and
+	//                             k the actual level of the
+	//								levelwise approach
+	// and the transversals including an itemset of freqTr
+	// ( same result as Trie::trMinOpt and Trie::trMinIopt )
+	// -------------------------------------------------------------
+
+	Trie< Item > * trMinOpt( int n, int k, Trie< Item > * inFreqTr = 0 ) ;
+
+};
+
+#endif
@@ -0,0 +1,333 @@
+/*----------------------------------------------------------------------
+  File    : OutputSink.cpp
+  Contents: Class that write the itemsets into a file through a large
+            buffer : the names of the items ( their ids given by remap )
+            are converted to decimal once and copied, the numbers are
+            converted without the streams and the buffer is written
+            with one system call when it is full. The file may be
+            written directly ( O_DIRECT, without the page cache ) or
+            through a memory mapping
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "OutputSink.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+*  default constructor, the buffer is aligned
+*  for the writes with O_DIRECT
+*/
+
+OutputSink::OutputSink()
+{
+	fd = -1 ;
+
+	owned = false ;
+
+	mode = SINK_WRITE ;
+
+	used = 0 ;
+
+	offset = 0 ;
+
+	fileSize = 0 ;
+
+	failed = false ;
+
+	remap = 0 ;
+
+	buffer = (char *)aligned_alloc( BLOCK, CAPACITY ) ;
+}
+
+OutputSink::~OutputSink()
+{
+	close() ;
+
+	free( buffer ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that create ( or truncate ) the file, if the
+*  file system refuses O_DIRECT the file is written with
+*  the system call write
+*/
+
+bool OutputSink::open( const char * fileName, SinkMode inMode )
+{
+	close() ;
+
+	mode = inMode ;
+
+	if( mode == SINK_DIRECT )
+	{
+		fd = ::open( fileName, O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0666 ) ;
+
+		if( fd < 0 )
+			mode = SINK_WRITE ;
+	}
+
+	if( fd < 0 )
+		fd = ::open( fileName, ( mode == SINK_MMAP ? O_RDWR : O_WRONLY ) | O_CREAT | O_TRUNC, 0666 ) ;
+
+	owned = true ;
+
+	used = 0 ;
+	offset = 0 ;
+	fileSize = 0 ;
+	failed = ( fd < 0 ) ;
+
+	return fd >= 0 ;
+}
+
+void OutputSink::attach( int inFd )
+{
+	close() ;
+
+	fd = inFd ;
+
+	owned = false ;
+
+	mode = SINK_WRITE ;
+
+	used = 0 ;
+	offset = 0 ;
+	fileSize = 0 ;
+	failed = false ;
+}
+
+/**
+*  method that write the buffer, with O_DIRECT the
+*  last block is padded and the file is truncated
+*  to its size, a mapped file is truncated too
+*/
+
+void OutputSink::close()
+{
+	if( fd < 0 )
+		return ;
+
+	flushBuffer( true ) ;
+
+	if( ( mode != SINK_WRITE ) && ( ftruncate( fd, offset ) != 0 ) )
+		failed = true ;
+
+	if( owned )
+		::close( fd ) ;
+
+	fd = -1 ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method initializing the table mapping the ids of the
+*  items to their names, the names converted are cleared
+*/
+
+void OutputSink::setRemap( int * inRemap )
+{
+	if( inRemap != remap )
+		names.clear() ;
+
+	remap = inRemap ;
+}
+
+/**
+*  convert the name of the item id once
+*/
+
+void OutputSink::setName( unsigned int id )
+{
+	char digits[ 24 ] ;
+
+	int n = 0 ;
+
+	long number = remap ? remap[ id ] : (long)id ;
+
+	unsigned long value = ( number < 0 ) ? 0ul - (unsigned long)number : (unsigned long)number ;
+
+	do
+	{
+		digits[ n++ ] = '0' + value % 10 ;
+
+		value /= 10 ;
+	}
+	while( value != 0 ) ;
+
+	if( number < 0 )
+		digits[ n++ ] = '-' ;
+
+	if( id >= names.size() )
+		names.resize( id + 1 ) ;
+
+	names[ id ].assign( digits, digits + n ) ;
+
+	reverse( names[ id ].begin(), names[ id ].end() ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+void OutputSink::putText( const char * text )
+{
+	size_t size = strlen( text ) ;
+
+	reserve( size ) ;
+
+	memcpy( buffer + used, text, size ) ;
+
+	used += size ;
+}
+
+/**
+*  append a number in decimal, the digits
+*  are found from the lowest one
+*/
+
+void OutputSink::putNumber( long number )
+{
+	char digits[ 24 ] ;
+
+	int n = 0 ;
+
+	unsigned long value = ( number < 0 ) ? 0ul - (unsigned long)number : (unsigned long)number ;
+
+	do
+	{
+		digits[ n++ ] = '0' + value % 10 ;
+
+		value /= 10 ;
+	}
+	while( value != 0 ) ;
+
+	if( number < 0 )
+		digits[ n++ ] = '-' ;
+
+	reserve( n ) ;
+
+	while( n > 0 )
+		buffer[ used++ ] = digits[ --n ] ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  write size bytes of the buffer at offset
+*/
+
+void OutputSink::writeBuffer( size_t size )
+{
+	size_t done = 0 ;
+
+	ssize_t res ;
+
+	if( mode == SINK_MMAP )
+	{
+		// the file grows by doubling its size and only
+		// the pages including the buffer are mapped
+
+		if( offset + size > fileSize )
+		{
+			fileSize = max( offset + size, max( 2 * fileSize, CAPACITY ) ) ;
+
+			if( ftruncate( fd, fileSize ) != 0 )
+			{
+				failed = true ;
+				return ;
+			}
+		}
+
+		size_t page = sysconf( _SC_PAGESIZE ) ;
+
+		size_t start = offset - offset % page ;
+
+		void * map = mmap( 0, offset + size - start, PROT_WRITE, MAP_SHARED, fd, start ) ;
+
+		if( map == MAP_FAILED )
+		{
+			failed = true ;
+			return ;
+		}
+
+		memcpy( (char *)map + ( offset - start ), buffer, size ) ;
+
+		munmap( map, offset + size - start ) ;
+
+		offset += size ;
+
+		return ;
+	}
+
+	while( done < size )
+	{
+		res = ::write( fd, buffer + done, size - done ) ;
+
+		if( res < 0 )
+		{
+			if( errno == EINTR )
+				continue ;
+
+			failed = true ;
+			return ;
+		}
+
+		done += res ;
+	}
+
+	offset += size ;
+}
+
+/**
+*  write the buffer, with O_DIRECT only whole blocks are
+*  written and the rest is moved to the beginning of the
+*  buffer, except for the last write where it is padded
+*  ( the file is truncated by close )
+*/
+
+void OutputSink::flushBuffer( bool last )
+{
+	size_t size = used ;
+
+	if( ( fd < 0 ) || failed || ( used == 0 ) )
+	{
+		used = 0 ;
+		return ;
+	}
+
+	if( mode == SINK_DIRECT )
+	{
+		size = used - used % BLOCK ;
+
+		if( last && ( size < used ) )
+		{
+			memset( buffer + used, 0, BLOCK - used % BLOCK ) ;
+
+			writeBuffer( size + BLOCK ) ;
+
+			offset -= BLOCK - used % BLOCK ;
+
+			used = 0 ;
+
+			return ;
+		}
+
+		writeBuffer( size ) ;
+
+		memmove( buffer, buffer + size, used - size ) ;
+
+		used -= size ;
+
+		return ;
+	}
+
+	writeBuffer( size ) ;
+
+	used = 0 ;
+}
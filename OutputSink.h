@@ -0,0 +1,154 @@
+/*----------------------------------------------------------------------
+  File    : OutputSink.h
+  Contents: Class that write the itemsets into a file through a large
+            buffer : the names of the items ( their ids given by remap )
+            are converted to decimal once and copied, the numbers are
+            converted without the streams and the buffer is written
+            with one system call when it is full. The file may be
+            written directly ( O_DIRECT, without the page cache ) or
+            through a memory mapping
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#ifndef OUTPUTSINK_H
+#define OUTPUTSINK_H
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// ------------------------------------------------
+// way the buffer is written into the file
+// SINK_WRITE : system call write
+// SINK_DIRECT : write with O_DIRECT, by blocks of
+//           BLOCK bytes ( SINK_WRITE is used if the
+//           file system doesn't support it )
+// SINK_MMAP : copy into a mapping of the file
+// ------------------------------------------------
+
+enum SinkMode { SINK_WRITE, SINK_DIRECT, SINK_MMAP } ;
+
+class OutputSink
+{
+protected:
+
+	static const size_t CAPACITY = 1 << 20 ;	// size of the buffer
+
+	static const size_t BLOCK = 4096 ;	// alignment of O_DIRECT
+
+	int fd ;
+
+	bool owned ;	// true if fd is closed by close
+
+	SinkMode mode ;
+
+	char * buffer ;
+
+	size_t used ;	// number of bytes in the buffer
+
+	size_t offset ;	// number of bytes written before the buffer
+
+	size_t fileSize ;	// size of the file mapped ( SINK_MMAP )
+
+	bool failed ;
+
+	// ------------------------------------------------
+	// table mapping the internal ids to the names of
+	// the items ( 0 to write the internal ids ) and
+	// names in decimal of the ids already written
+	// ------------------------------------------------
+
+	int * remap ;
+
+	vector< string > names ;
+
+	void setName( unsigned int id ) ;
+
+	void writeBuffer( size_t size ) ;
+
+	void flushBuffer( bool last ) ;
+
+	void reserve( size_t size ) { if( used + size > CAPACITY ) flushBuffer( false ) ; }
+
+public:
+
+	OutputSink() ;
+
+	~OutputSink() ;
+
+	// ------------------------------------------------
+	// method that create ( or truncate ) the file,
+	// return false if the file can't be opened
+	// ------------------------------------------------
+
+	bool open( const char * fileName, SinkMode inMode = SINK_WRITE ) ;
+
+	// ------------------------------------------------
+	// method that write into an open file descriptor
+	// ( 1 for the standard output ), it is not closed
+	// ------------------------------------------------
+
+	void attach( int inFd ) ;
+
+	bool isOpen() const { return fd >= 0 ; }
+
+	// ------------------------------------------------
+	// method that write the buffer, the size of the
+	// file is set and the file closed
+	// ------------------------------------------------
+
+	void close() ;
+
+	// ------------------------------------------------
+	// method initializing the table mapping the ids
+	// of the items to their names
+	// ------------------------------------------------
+
+	void setRemap( int * inRemap ) ;
+
+	// ------------------------------------------------
+	// methods that append the name of the item id
+	// followed by a space, a character, a string and
+	// a number in decimal
+	// ------------------------------------------------
+
+	void putItem( unsigned int id )
+	{
+		if( ( id >= names.size() ) || names[ id ].empty() )
+			setName( id ) ;
+
+		const string & name = names[ id ] ;
+
+		reserve( name.size() + 1 ) ;
+
+		memcpy( buffer + used, name.data(), name.size() ) ;
+
+		used += name.size() ;
+
+		buffer[ used++ ] = ' ' ;
+	}
+
+	void putChar( char c ) { reserve( 1 ) ; buffer[ used++ ] = c ; }
+
+	void putText( const char * text ) ;
+
+	void putNumber( long number ) ;
+
+	// ------------------------------------------------
+	// method that write the buffer ( with O_DIRECT the
+	// last incomplete block waits until close )
+	// ------------------------------------------------
+
+	void flush() { flushBuffer( false ) ; }
+
+	// ------------------------------------------
+	// false if a write has failed ( disk full )
+	// ------------------------------------------
+
+	bool good() const { return ! failed ; }
+
+};
+
+#endif
@@ -0,0 +1,176 @@
+/*----------------------------------------------------------------------
+  File    : Scheduler.cpp
+  Contents: Class that choose, at each level of the levelwise phase of
+            ABS, between one more levelwise pass and a jump ( the
+            dualisation of the negative border and the counting of the
+            complements of the transversals ). The costs are estimated
+            from the timings and the sizes of the borders measured
+            during the run, each decision and each jump are logged
+            with their estimated and measured costs to tune the model
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "Scheduler.h"
+
+#include <cstring>
+
+/**
+*  default constructor, the rates are only used
+*  until they are measured during the run
+*/
+
+Scheduler::Scheduler()
+{
+	log = &cout ;
+
+	countRate = 1e-6 ;
+
+	dualRate = 5e-8 ;
+
+	complFactor = 20 ;
+
+	prevFreq = 0 ;
+
+	nbEdges = 0 ;
+
+	dualEstimate = 0 ;
+
+	complEstimate = 0 ;
+
+	nbJumps = 0 ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that open the log ( "-" for the
+*  standard output )
+*/
+
+bool Scheduler::open( const char * fileName )
+{
+	if( strcmp( fileName, "-" ) == 0 )
+	{
+		log = &cout ;
+
+		return true ;
+	}
+
+	logFile.open( fileName ) ;
+
+	log = &logFile ;
+
+	return logFile.is_open() ;
+}
+
+void Scheduler::setRates( double inDualRate, double inComplFactor )
+{
+	if( inDualRate > 0 )
+		dualRate = inDualRate ;
+
+	if( inComplFactor > 0 )
+		complFactor = inComplFactor ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+void Scheduler::start( int nbItems )
+{
+	prevFreq = nbItems ;
+
+	nbEdges = 0 ;
+
+	nbJumps = 0 ;
+
+	*log<<"start\t items : "<<nbItems<<"\t dual rate : "<<dualRate<<"\t compl factor : "<<complFactor<<endl;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  the jump after this level dualises the infrequent
+*  itemsets found until now and counts the complements
+*  of about as many transversals as frequent itemsets
+*  of the last level. One more pass counts the next
+*  candidates, estimated from the growth of the
+*  frequent itemsets : the cheapest one is chosen
+*/
+
+bool Scheduler::continueLevelwise( int level, unsigned long nbCand, unsigned long nbFreq, double seconds )
+{
+	double nextCand ;
+
+	double jumpCost, passCost ;
+
+	bool res ;
+
+	if( nbCand != 0 )
+		countRate = seconds / nbCand ;
+
+	nbEdges += nbCand - nbFreq ;
+
+	nextCand = ( prevFreq > 0 ) ? (double)nbCand * nbFreq / prevFreq : 0 ;
+
+	dualEstimate = dualCost( nbEdges, nbFreq ) ;
+
+	complEstimate = complCost( nbFreq ) ;
+
+	jumpCost = dualEstimate + complEstimate ;
+
+	passCost = countRate * nextCand ;
+
+	// a jump needs a negative border, the passes
+	// of the first levels are cheap
+
+	res = ( level < 3 ) || ( nbEdges == 0 ) || ( passCost < jumpCost ) ;
+
+	*log<<"level "<<level<<"\t candidates : "<<nbCand<<"\t frequent : "<<nbFreq<<"\t time : "<<seconds<<"s"
+		<<"\t next pass : "<<passCost<<"s ( "<<(unsigned long)nextCand<<" candidates )"
+		<<"\t jump : "<<jumpCost<<"s ( dualisation "<<dualEstimate<<"s, complements "<<complEstimate<<"s )"
+		<<"\t decision : "<<( res ? "levelwise" : "jump" )<<endl;
+
+	prevFreq = nbFreq ;
+
+	return res ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  the costs measured replace the rates of the
+*  model, the estimates of the first jump are the
+*  ones of the decision
+*/
+
+void Scheduler::jumped( int level, unsigned long edges, unsigned long sumSizes, unsigned long nbTr, double dualSeconds,
+						unsigned long nbCompl, double complSeconds )
+{
+	if( nbJumps != 0 )
+	{
+		dualEstimate = dualRate * sumSizes ;
+
+		complEstimate = complCost( nbCompl ) ;
+	}
+
+	*log<<"jump "<<nbJumps<<"\t level : "<<level<<"\t edges : "<<edges<<"\t Tr Min : "<<nbTr<<"\t total : "<<sumSizes
+		<<"\t dualisation : "<<dualSeconds<<"s ( estimated "<<dualEstimate<<"s )"
+		<<"\t complements : "<<nbCompl<<"\t time : "<<complSeconds<<"s ( estimated "<<complEstimate<<"s )";
+
+	if( ( sumSizes != 0 ) && ( dualSeconds > 0 ) )
+		dualRate = dualSeconds / sumSizes ;
+
+	if( ( nbCompl != 0 ) && ( complSeconds > 0 ) )
+		complFactor = complSeconds / nbCompl / countRate ;
+
+	*log<<"\t dual rate : "<<dualRate<<"\t compl factor : "<<complFactor<<endl;
+
+	nbJumps++ ;
+}
+
+void Scheduler::counted( int level, unsigned long nbCand, double seconds )
+{
+	*log<<"count\t level : "<<level<<"\t candidates : "<<nbCand<<"\t time : "<<seconds<<"s ( estimated "<<countRate * nbCand<<"s )"<<endl;
+
+	if( ( nbCand != 0 ) && ( seconds > 0 ) )
+		countRate = seconds / nbCand ;
+}
@@ -0,0 +1,127 @@
+/*----------------------------------------------------------------------
+  File    : Scheduler.h
+  Contents: Class that choose, at each level of the levelwise phase of
+            ABS, between one more levelwise pass and a jump ( the
+            dualisation of the negative border and the counting of the
+            complements of the transversals ). The costs are estimated
+            from the timings and the sizes of the borders measured
+            during the run, each decision and each jump are logged
+            with their estimated and measured costs to tune the model
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+class Scheduler
+{
+protected:
+
+	ofstream logFile ;
+
+	ostream * log ;	// logFile or cout
+
+	// ------------------------------------------------
+	// seconds by candidate generated and counted
+	// during the last levelwise pass
+	// ------------------------------------------------
+
+	double countRate ;
+
+	// ------------------------------------------------
+	// seconds by transversal kept after an edge during
+	// the dualisation ( see Hypergraph::getSumSizes )
+	// ------------------------------------------------
+
+	double dualRate ;
+
+	// ------------------------------------------------
+	// cost of the counting of a complement compared
+	// to the one of a candidate of the levelwise pass
+	// ------------------------------------------------
+
+	double complFactor ;
+
+	// ------------------------------------------------
+	// number of frequent itemsets and of infrequent
+	// itemsets found at the previous levels
+	// ------------------------------------------------
+
+	double prevFreq ;
+
+	double nbEdges ;
+
+	// ------------------------------------------------
+	// costs estimated for the next jump, and number
+	// of jumps done
+	// ------------------------------------------------
+
+	double dualEstimate ;
+
+	double complEstimate ;
+
+	int nbJumps ;
+
+	// ------------------------------------------------
+	// estimated costs of the dualisation of edges and
+	// of the counting of the complements of nbTr
+	// transversals
+	// ------------------------------------------------
+
+	double dualCost( double edges, double nbTr ) const { return dualRate * edges * nbTr / 2 ; }
+
+	double complCost( double nbTr ) const { return countRate * complFactor * nbTr ; }
+
+public:
+
+	Scheduler() ;
+
+	// ------------------------------------------------
+	// method that open the log ( "-" for the standard
+	// output ), return false if it can't be opened
+	// ------------------------------------------------
+
+	bool open( const char * fileName ) ;
+
+	// ------------------------------------------------
+	// method initializing the coefficients of the
+	// model ( measured on a previous run, see the log )
+	// ------------------------------------------------
+
+	void setRates( double inDualRate, double inComplFactor ) ;
+
+	// ------------------------------------------------
+	// method called before the levelwise phase, on
+	// nbItems frequent items
+	// ------------------------------------------------
+
+	void start( int nbItems ) ;
+
+	// ------------------------------------------------
+	// method called after the levelwise pass of level,
+	// that counted nbCand candidates in seconds and
+	// found nbFreq frequent, return true if one more
+	// pass costs less than the jump it avoids
+	// ------------------------------------------------
+
+	bool continueLevelwise( int level, unsigned long nbCand, unsigned long nbFreq, double seconds ) ;
+
+	// ------------------------------------------------
+	// methods called after each jump and each pass of
+	// the bottom up step, they log the measured costs
+	// and update the rates of the model
+	// ------------------------------------------------
+
+	void jumped( int level, unsigned long edges, unsigned long sumSizes, unsigned long nbTr, double dualSeconds,
+					unsigned long nbCompl, double complSeconds ) ;
+
+	void counted( int level, unsigned long nbCand, double seconds ) ;
+
+};
+
+#endif
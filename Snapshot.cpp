@@ -0,0 +1,290 @@
+/*----------------------------------------------------------------------
+  File    : Snapshot.cpp
+  Contents: Classes that write and read a snapshot of the state of a run
+            ( numbers and tries ) in a compact binary file, to resume
+            the run later. The tries are stored as their itemsets in
+            the order of the trie, each one as the items that are not
+            shared with the previous one and its support ( a 0 ends
+            the trie ), all the numbers are coded on a variable
+            number of bytes. The file is written under another name
+            and renamed once complete, so the last snapshot is never
+            lost during a write
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "Snapshot.h"
+#include "TrieIterator.h"
+
+#include <cstdio>
+#include <cstring>
+
+/**
+*  functor appending the itemsets of a trie to a snapshot,
+*  only the items after the prefix shared with the previous
+*  itemset are written ( the size of the prefix plus 1, so
+*  that 0 marks the end of the trie )
+*/
+
+template< class Item >
+struct SnapshotItemsets
+{
+	SnapshotWriter< Item > & writer ;
+
+	vector< Item > previous ;
+
+	SnapshotItemsets( SnapshotWriter< Item > & inWriter ) : writer( inWriter ) {}
+
+	void write( vector< Item > * itemset, unsigned long support )
+	{
+		unsigned int prefix = 0 ;
+
+		while( ( prefix < previous.size() ) && ( prefix < itemset->size() ) && ( previous[ prefix ] == (*itemset)[ prefix ] ) )
+			prefix++ ;
+
+		writer.putNumber( prefix + 1 ) ;
+		writer.putNumber( itemset->size() - prefix ) ;
+
+		for( unsigned int i = prefix; i < itemset->size() ; i++ )
+			writer.putNumber( (*itemset)[ i ] ) ;
+
+		writer.putNumber( support ) ;
+
+		previous = *itemset ;
+	}
+
+	void operator()( vector< Item > * itemset, Trie< Item > * node ) { write( itemset, node->getSupport() ) ; }
+
+	void operator()( vector< Item > * itemset, unsigned int support ) { write( itemset, support ) ; }
+};
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that create the temporary file of
+*  the snapshot and write its header
+*/
+
+template< class Item >
+bool SnapshotWriter< Item >::open( const char * inFileName )
+{
+	fileName = inFileName ;
+
+	if( ! sink.open( ( fileName + ".tmp" ).c_str() ) )
+		return false ;
+
+	sink.putText( SNAPSHOT_MAGIC ) ;
+
+	return true ;
+}
+
+/**
+*  method that close the file and rename it, the
+*  previous snapshot is kept if a write failed
+*/
+
+template< class Item >
+bool SnapshotWriter< Item >::close()
+{
+	sink.close() ;
+
+	if( ! sink.good() )
+		return false ;
+
+	return rename( ( fileName + ".tmp" ).c_str(), fileName.c_str() ) == 0 ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  write a number on as many bytes as needed, 7 bits
+*  by byte, the high bit is set on all the bytes
+*  except the last one
+*/
+
+template< class Item >
+void SnapshotWriter< Item >::putNumber( unsigned long number )
+{
+	while( number >= 0x80 )
+	{
+		sink.putChar( (char)( ( number & 0x7F ) | 0x80 ) ) ;
+
+		number >>= 7 ;
+	}
+
+	sink.putChar( (char)number ) ;
+}
+
+/**
+*  a real is written with the bytes of its representation
+*/
+
+template< class Item >
+void SnapshotWriter< Item >::putDouble( double number )
+{
+	unsigned long bits ;
+
+	memcpy( &bits, &number, sizeof( bits ) ) ;
+
+	putNumber( bits ) ;
+}
+
+/**
+*  the support of the root ( number of itemsets ), the
+*  itemsets and the end of the trie
+*/
+
+template< class Item >
+void SnapshotWriter< Item >::putTrie( Trie< Item > * trie )
+{
+	SnapshotItemsets< Item > writer( *this ) ;
+
+	putNumber( trie->getSupport() ) ;
+
+	if( trie->getChildren() != 0 )
+		visitItemsets( trie, writer ) ;
+
+	putNumber( 0 ) ;
+}
+
+template< class Item >
+void SnapshotWriter< Item >::putTrie( CompactTrie< Item > & trie )
+{
+	SnapshotItemsets< Item > writer( *this ) ;
+
+	putNumber( trie.getSupport() ) ;
+
+	trie.visitItemsets( writer ) ;
+
+	putNumber( 0 ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that read the file and check its header
+*/
+
+template< class Item >
+bool SnapshotReader< Item >::open( const char * fileName )
+{
+	ifstream pFile( fileName, ios::in | ios::binary ) ;
+
+	data.clear() ;
+
+	pos = 8 ;
+
+	failed = true ;
+
+	if( ! pFile.is_open() )
+		return false ;
+
+	data.assign( istreambuf_iterator< char >( pFile ), istreambuf_iterator< char >() ) ;
+
+	failed = ( data.size() < 8 ) || ( memcmp( &data[ 0 ], SNAPSHOT_MAGIC, 8 ) != 0 ) ;
+
+	return ! failed ;
+}
+
+/**
+*  read a number written by SnapshotWriter::putNumber,
+*  0 if the file is truncated
+*/
+
+template< class Item >
+unsigned long SnapshotReader< Item >::getNumber()
+{
+	unsigned long number = 0 ;
+
+	int shift = 0 ;
+
+	unsigned char byte ;
+
+	while( pos < data.size() )
+	{
+		byte = data[ pos++ ] ;
+
+		number |= (unsigned long)( byte & 0x7F ) << shift ;
+
+		if( ( byte & 0x80 ) == 0 )
+			return number ;
+
+		shift += 7 ;
+	}
+
+	failed = true ;
+
+	return 0 ;
+}
+
+template< class Item >
+double SnapshotReader< Item >::getDouble()
+{
+	unsigned long bits = getNumber() ;
+
+	double number ;
+
+	memcpy( &number, &bits, sizeof( number ) ) ;
+
+	return number ;
+}
+
+/**
+*  the itemsets are rebuilt from their prefix and inserted
+*  with their support, then the support of the root is set
+*/
+
+template< class Item >
+void SnapshotReader< Item >::getTrie( Trie< Item > * trie )
+{
+	vector< Item > itemset ;
+
+	unsigned long support, prefix, size ;
+
+	support = getNumber() ;
+
+	while( ( ( prefix = getNumber() ) != 0 ) && ! failed )
+	{
+		prefix-- ;
+
+		size = getNumber() ;
+
+		if( prefix > itemset.size() )
+		{
+			failed = true ;
+			return ;
+		}
+
+		itemset.resize( prefix ) ;
+
+		for( unsigned long j = 0; j < size ; j++ )
+			itemset.push_back( (Item)getNumber() ) ;
+
+		trie->insert( &itemset, getNumber() ) ;
+	}
+
+	trie->setSupport( support ) ;
+}
+
+template< class Item >
+void SnapshotReader< Item >::getTrie( CompactTrie< Item > & trie )
+{
+	Trie< Item > * tmp = new Trie< Item >( 0 ) ;
+
+	getTrie( tmp ) ;
+
+	trie.build( tmp ) ;
+
+	delete tmp ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+// instantiation for the item identifiers on 8, 16 and 32 bits
+
+template class SnapshotWriter< unsigned char > ;
+template class SnapshotWriter< short unsigned > ;
+template class SnapshotWriter< unsigned int > ;
+
+template class SnapshotReader< unsigned char > ;
+template class SnapshotReader< short unsigned > ;
+template class SnapshotReader< unsigned int > ;
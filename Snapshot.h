@@ -0,0 +1,109 @@
+/*----------------------------------------------------------------------
+  File    : Snapshot.h
+  Contents: Classes that write and read a snapshot of the state of a run
+            ( numbers and tries ) in a compact binary file, to resume
+            the run later. The tries are stored as their itemsets in
+            the order of the trie, each one as the items that are not
+            shared with the previous one and its support ( a 0 ends
+            the trie ), all the numbers are coded on a variable
+            number of bytes. The file is written under another name
+            and renamed once complete, so the last snapshot is never
+            lost during a write
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "CompactTrie.h"
+
+#include <string>
+
+static const char SNAPSHOT_MAGIC[] = "ABSSNAP1" ;
+
+template< class Item >
+class SnapshotWriter
+{
+protected:
+
+	OutputSink sink ;
+
+	string fileName ;
+
+public:
+
+	// ------------------------------------------------
+	// method that create the temporary file of the
+	// snapshot, return false if it can't be opened
+	// ------------------------------------------------
+
+	bool open( const char * inFileName ) ;
+
+	// ------------------------------------------------
+	// method that close the file and replace the last
+	// snapshot with it, return false if a write failed
+	// ------------------------------------------------
+
+	bool close() ;
+
+	// ------------------------------------------------
+	// methods that append a number, a real, the
+	// itemsets of a trie with their supports ( and the
+	// support of its root ) and a compact trie
+	// ------------------------------------------------
+
+	void putNumber( unsigned long number ) ;
+
+	void putDouble( double number ) ;
+
+	void putTrie( Trie< Item > * trie ) ;
+
+	void putTrie( CompactTrie< Item > & trie ) ;
+
+};
+
+template< class Item >
+class SnapshotReader
+{
+protected:
+
+	vector< char > data ;	// content of the file
+
+	size_t pos ;	// next byte to read
+
+	bool failed ;
+
+public:
+
+	SnapshotReader() : pos( 0 ), failed( true ) {}
+
+	// ------------------------------------------------
+	// method that read the file, return false if it
+	// can't be read or is not a snapshot
+	// ------------------------------------------------
+
+	bool open( const char * fileName ) ;
+
+	// ------------------------------------------------
+	// methods that read the values in the order they
+	// were written, the itemsets are inserted into
+	// trie ( it must be empty )
+	// ------------------------------------------------
+
+	unsigned long getNumber() ;
+
+	double getDouble() ;
+
+	void getTrie( Trie< Item > * trie ) ;
+
+	void getTrie( CompactTrie< Item > & trie ) ;
+
+	// ------------------------------------------
+	// false if the file was truncated
+	// ------------------------------------------
+
+	bool good() const { return ! failed ; }
+
+};
+
+#endif
@@ -0,0 +1,343 @@
+/*----------------------------------------------------------------------
+  File    : SubsetIndex.cpp
+  Contents: Class that store a set of itemsets to search quickly if
+            one of them including a given item is included into an
+            itemset : the itemsets are indexed by each of their items
+            and each one has a signature of 64 bits ( one bit by item
+            modulo 64 ), so most of the itemsets that are not included
+            are rejected without comparing the items.
+            It is used for the transversals that generated frequent
+            itemsets ( freqTr ) during the dualisation, to find
+            the itemsets of the positive border that are included
+            into another one, and to bound the frequent itemsets by
+            the positive border of a lower threshold
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "SubsetIndex.h"
+#include "TrieIterator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+// ------------------------------------------------------
+// number of itemsets given at once to a thread searching
+// the itemsets that are not maximal
+// ------------------------------------------------------
+
+static const unsigned int MAXIMAL_CHUNK = 4096 ;
+
+/**
+*  signature of an itemset : the bit ( item modulo 64 )
+*  is set for each item, if an itemset is included into
+*  another one its signature is included into the other
+*/
+
+template< class Item >
+uint64_t SubsetIndex< Item >::signature( const Item * itemset, int size )
+{
+	uint64_t res = 0 ;
+
+	for( int i = 0; i < size ; i++ )
+		res |= (uint64_t)1 << ( itemset[ i ] % 64 ) ;
+
+	return res ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  the itemsets of trie are stored and indexed
+*/
+
+template< class Item >
+void SubsetIndex< Item >::build( Trie< Item > * trie )
+{
+	TrieIterator< Item > it( trie ) ;
+
+	vector< Item > * vect ;
+
+	unsigned int num ;
+
+	items.clear() ;
+	start.assign( 1, 0 ) ;
+	signatures.clear() ;
+	postings.clear() ;
+
+	if( ( trie == 0 ) || ( trie->getChildren() == 0 ) )
+		return ;
+
+	while( it.next() )
+	{
+		vect = it.getItemset() ;
+
+		num = signatures.size() ;
+
+		items.insert( items.end(), vect->begin(), vect->end() ) ;
+
+		start.push_back( items.size() ) ;
+
+		signatures.push_back( signature( &(*vect)[ 0 ], vect->size() ) ) ;
+
+		// the items are ordered, the last one is the greatest
+
+		if( vect->back() >= postings.size() )
+			postings.resize( vect->back() + 1 ) ;
+
+		for( unsigned int i = 0; i < vect->size() ; i++ )
+			postings[ (*vect)[ i ] ].push_back( num ) ;
+	}
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method searching if one itemset including the item
+*  itemset[ mpos ] is included into itemset, only the
+*  itemsets of its posting list are tested, first with
+*  their signature then item by item
+*/
+
+template< class Item >
+bool SubsetIndex< Item >::includedInWith( vector< Item > * itemset, int mpos ) const
+{
+	Item item = (*itemset)[ mpos ] ;
+
+	uint64_t sig ;
+
+	unsigned int num, i, j ;
+
+	if( item >= postings.size() || postings[ item ].empty() )
+		return false ;
+
+	sig = signature( &(*itemset)[ 0 ], itemset->size() ) ;
+
+	const vector< unsigned int > & posting = postings[ item ] ;
+
+	for( unsigned int p = 0; p < posting.size() ; p++ )
+	{
+		num = posting[ p ] ;
+
+		if( ( signatures[ num ] & ~sig ) != 0 )
+			continue ;
+
+		if( start[ num + 1 ] - start[ num ] > itemset->size() )
+			continue ;
+
+		// the two itemsets are ordered
+
+		i = start[ num ] ;
+		j = 0 ;
+
+		while( ( i < start[ num + 1 ] ) && ( j < itemset->size() ) && ( items[ i ] >= (*itemset)[ j ] ) )
+		{
+			if( items[ i ] == (*itemset)[ j ] )
+				i++ ;
+
+			j++ ;
+		}
+
+		if( i == start[ num + 1 ] )
+			return true ;
+	}
+
+	return false ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method searching if the itemset number num is included
+*  into another itemset of the index : only the itemsets of
+*  the shortest posting list of its items that are larger
+*  are tested, first with their signature then item by item
+*/
+
+template< class Item >
+bool SubsetIndex< Item >::includedInOther( unsigned int num ) const
+{
+	unsigned int size = start[ num + 1 ] - start[ num ] ;
+
+	unsigned int other, i, j, best ;
+
+	if( size == 0 )
+		return getSupport() > 1 ;
+
+	best = start[ num ] ;
+
+	for( i = start[ num ] + 1; i < start[ num + 1 ] ; i++ )
+		if( postings[ items[ i ] ].size() < postings[ items[ best ] ].size() )
+			best = i ;
+
+	const vector< unsigned int > & posting = postings[ items[ best ] ] ;
+
+	for( unsigned int p = 0; p < posting.size() ; p++ )
+	{
+		other = posting[ p ] ;
+
+		// two different itemsets of the same size
+		// are not included into each other
+
+		if( start[ other + 1 ] - start[ other ] <= size )
+			continue ;
+
+		if( ( signatures[ num ] & ~signatures[ other ] ) != 0 )
+			continue ;
+
+		// the two itemsets are ordered
+
+		i = start[ num ] ;
+		j = start[ other ] ;
+
+		while( ( i < start[ num + 1 ] ) && ( j < start[ other + 1 ] ) && ( items[ i ] >= items[ j ] ) )
+		{
+			if( items[ i ] == items[ j ] )
+				i++ ;
+
+			j++ ;
+		}
+
+		if( i == start[ num + 1 ] )
+			return true ;
+	}
+
+	return false ;
+}
+
+/**
+*  method searching if itemset is included into one itemset
+*  of the index : only the itemsets of the shortest posting
+*  list of its items are tested, first with their signature
+*  then item by item
+*/
+
+template< class Item >
+bool SubsetIndex< Item >::includedIn( vector< Item > * itemset ) const
+{
+	uint64_t sig ;
+
+	unsigned int num, i, j, best ;
+
+	if( itemset->empty() )
+		return ! empty() ;
+
+	for( i = 0; i < itemset->size() ; i++ )
+		if( ( (*itemset)[ i ] >= postings.size() ) || postings[ (*itemset)[ i ] ].empty() )
+			return false ;
+
+	sig = signature( &(*itemset)[ 0 ], itemset->size() ) ;
+
+	best = 0 ;
+
+	for( i = 1; i < itemset->size() ; i++ )
+		if( postings[ (*itemset)[ i ] ].size() < postings[ (*itemset)[ best ] ].size() )
+			best = i ;
+
+	const vector< unsigned int > & posting = postings[ (*itemset)[ best ] ] ;
+
+	for( unsigned int p = 0; p < posting.size() ; p++ )
+	{
+		num = posting[ p ] ;
+
+		if( ( sig & ~signatures[ num ] ) != 0 )
+			continue ;
+
+		if( start[ num + 1 ] - start[ num ] < itemset->size() )
+			continue ;
+
+		// the two itemsets are ordered
+
+		i = 0 ;
+		j = start[ num ] ;
+
+		while( ( i < itemset->size() ) && ( j < start[ num + 1 ] ) && ( (*itemset)[ i ] >= items[ j ] ) )
+		{
+			if( (*itemset)[ i ] == items[ j ] )
+				i++ ;
+
+			j++ ;
+		}
+
+		if( i == itemset->size() )
+			return true ;
+	}
+
+	return false ;
+}
+
+/**
+*  method that flag the itemsets included into another one :
+*  an itemset included into a non maximal itemset is included
+*  into its superset too, so all the itemsets are tested
+*  against the whole index, independently. They are sorted by
+*  decreasing size, the largest ones are maximal, and the
+*  others are taken by chunks of MAXIMAL_CHUNK itemsets of
+*  close sizes shared between nbThreads threads
+*/
+
+template< class Item >
+unsigned int SubsetIndex< Item >::flagNonMaximal( vector< char > & flags, int nbThreads ) const
+{
+	vector< unsigned int > order ;	// itemsets by decreasing size
+
+	vector< thread > workers ;
+
+	atomic< unsigned int > next( 0 ) ;	// first itemset of the next chunk
+
+	atomic< unsigned int > nbFlagged( 0 ) ;
+
+	unsigned int n = getSupport() ;
+
+	flags.assign( n, 0 ) ;
+
+	for( unsigned int num = 0; num < n ; num++ )
+		order.push_back( num ) ;
+
+	stable_sort( order.begin(), order.end(), [ this ]( unsigned int a, unsigned int b )
+		{ return start[ a + 1 ] - start[ a ] > start[ b + 1 ] - start[ b ] ; } ) ;
+
+	while( ( next < n ) && ( start[ order[ next ] + 1 ] - start[ order[ next ] ] == start[ order[ 0 ] + 1 ] - start[ order[ 0 ] ] ) )
+		next++ ;
+
+	auto work = [ & ]()
+	{
+		unsigned int first, last, flagged = 0 ;
+
+		while( ( first = next.fetch_add( MAXIMAL_CHUNK ) ) < n )
+		{
+			last = min( first + MAXIMAL_CHUNK, n ) ;
+
+			for( unsigned int o = first; o < last ; o++ )
+				if( includedInOther( order[ o ] ) )
+				{
+					flags[ order[ o ] ] = 1 ;
+
+					flagged++ ;
+				}
+		}
+
+		nbFlagged += flagged ;
+	} ;
+
+	if( ( nbThreads > 1 ) && ( n > MAXIMAL_CHUNK ) )
+	{
+		for( int t = 1; t < nbThreads ; t++ )
+			workers.push_back( thread( work ) ) ;
+	}
+
+	work() ;
+
+	for( unsigned int t = 0; t < workers.size() ; t++ )
+		workers[ t ].join() ;
+
+	return nbFlagged ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+// instantiation for the item identifiers on 8, 16 and 32 bits
+
+template class SubsetIndex< unsigned char > ;
+template class SubsetIndex< short unsigned > ;
+template class SubsetIndex< unsigned int > ;
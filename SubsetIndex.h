@@ -0,0 +1,101 @@
+/*----------------------------------------------------------------------
+  File    : SubsetIndex.h
+  Contents: Class that store a set of itemsets to search quickly if
+            one of them including a given item is included into an
+            itemset : the itemsets are indexed by each of their items
+            and each one has a signature of 64 bits ( one bit by item
+            modulo 64 ), so most of the itemsets that are not included
+            are rejected without comparing the items.
+            It is used for the transversals that generated frequent
+            itemsets ( freqTr ) during the dualisation, to find
+            the itemsets of the positive border that are included
+            into another one, and to bound the frequent itemsets by
+            the positive border of a lower threshold
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#ifndef SUBSETINDEX_H
+#define SUBSETINDEX_H
+
+#include "Trie.h"
+
+#include <cstdint>
+#include <vector>
+
+template< class Item >
+class SubsetIndex
+{
+protected:
+
+	// ------------------------------------------------
+	// items of the itemsets, stored one itemset after
+	// the other, position of the first item of each
+	// itemset ( the last value is the end of the last
+	// itemset ) and signature of each itemset
+	// ------------------------------------------------
+
+	vector< Item > items ;
+
+	vector< unsigned int > start ;
+
+	vector< uint64_t > signatures ;
+
+	// -----------------------------------------
+	// numbers of the itemsets including each
+	// item ( posting lists )
+	// -----------------------------------------
+
+	vector< vector< unsigned int > > postings ;
+
+	static uint64_t signature( const Item * itemset, int size ) ;
+
+public:
+
+	SubsetIndex() {}
+
+	// ------------------------------------------------
+	// the itemsets of trie are indexed ( trie may be 0 )
+	// ------------------------------------------------
+
+	SubsetIndex( Trie< Item > * trie ) { build( trie ) ; }
+
+	void build( Trie< Item > * trie ) ;
+
+	unsigned int getSupport() const { return start.empty() ? 0 : start.size() - 1 ; }
+
+	bool empty() const { return getSupport() == 0 ; }
+
+	// ------------------------------------------------------
+	// method searching if one itemset including the item
+	// itemset[ mpos ] is included into itemset
+	// ( see Trie::includedInWith )
+	// ------------------------------------------------------
+
+	bool includedInWith( vector< Item > * itemset, int mpos ) const ;
+
+	// ------------------------------------------------------
+	// method searching if the itemset number num ( in the
+	// order of the trie ) is included into another itemset
+	// of the index
+	// ------------------------------------------------------
+
+	bool includedInOther( unsigned int num ) const ;
+
+	// ------------------------------------------------------
+	// method searching if itemset is included into one
+	// itemset of the index
+	// ------------------------------------------------------
+
+	bool includedIn( vector< Item > * itemset ) const ;
+
+	// ------------------------------------------------------
+	// method that flag the itemsets included into another
+	// one ( not maximal ), nbThreads threads share them,
+	// return the number of itemsets flagged
+	// ------------------------------------------------------
+
+	unsigned int flagNonMaximal( vector< char > & flags, int nbThreads ) const ;
+
+};
+
+#endif
@@ -9,12 +9,27 @@
 ----------------------------------------------------------------------*/
 
 #include "Trie.h"
+#include "TrieIterator.h"
+#include "CompactTrie.h"
+#include "SubsetIndex.h"
+
+#include <algorithm>
+#include <thread>
+
+// ------------------------------------------------------
+// minimal number of candidates ( itemsets of Bi times
+// items of the edge ) to share their generation between
+// threads
+// ------------------------------------------------------
+
+static const unsigned long MIN_PARALLEL_CANDIDATES = 4096 ;
 
 /**
 *  method that allocate a set of child nodes
 */
 
-set<Trie> *Trie::makeChildren() 
+template< class Item >
+set<Trie< Item >> *Trie< Item >::makeChildren() 
 {
 	if(children) return children;
 	return children = new set<Trie>;
@@ -26,13 +41,14 @@ set<Trie> *Trie::makeChildren()
 *  method that delete recursively the sub tree of this node
 */
 
-int Trie::deleteChildren() 
+template< class Item >
+int Trie< Item >::deleteChildren() 
 {
 	int deleted=0;
 
 	if(children)
 	{
-		for(set<Trie>::iterator it = children->begin(); it != children->end(); it++)
+		for(typename set<Trie>::iterator it = children->begin(); it != children->end(); it++)
 		{
 		    Trie * tmpT = const_cast< Trie * >( &(*it) ) ;
 			deleted += tmpT->deleteChildren();
@@ -47,18 +63,61 @@ int Trie::deleteChildren()
 	return deleted;
 }
 
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method returning the number of nodes of the sub
+*  tree of this node ( this node is not counted )
+*/
+
+template< class Item >
+unsigned long Trie< Item >::countNodes() const
+{
+	unsigned long nb = 0 ;
+
+	if( children )
+		for( typename set<Trie>::iterator it = children->begin(); it != children->end(); it++ )
+			nb += 1 + it->countNodes() ;
+
+	return nb ;
+}
+
 // ---------------------------------------------------------------------------------------------- 
 
 /**
 *  affectation operator
 */
 
-Trie & Trie::operator = ( const Trie & inTrie ) 
+template< class Item >
+Trie< Item > & Trie< Item >::operator = ( const Trie & inTrie ) 
+{
+	if( this != &inTrie )
+	{
+		// the sub tree is duplicated before the old one
+		// is deleted since inTrie can be one of its nodes
+
+		set<Trie> * tmp = inTrie.children ? new set<Trie>( *inTrie.children ) : 0 ;
+
+		delete children ;
+
+		id =  inTrie.id ;
+
+		support = inTrie.support ;
+
+		children = tmp ;
+
+	}
+
+	return *this ;
+
+}
+
+template< class Item >
+Trie< Item > & Trie< Item >::operator = ( Trie && inTrie ) noexcept
 {
 	if( this != &inTrie )
 	{
-		if( children ) 
-			deleteChildren() ;
+		delete children ;
 
 		id =  inTrie.id ;
 
@@ -66,6 +125,7 @@ Trie & Trie::operator = ( const Trie & inTrie )
 
 		children = inTrie.children ;
 
+		inTrie.children = 0 ;
 	}
 
 	return *this ;
@@ -79,21 +139,24 @@ Trie & Trie::operator = ( const Trie & inTrie )
 *  this set is included into itemset
 */
 
-bool Trie::includedIn( short unsigned * itemset, int level ) 
+template< class Item >
+bool Trie< Item >::includedIn( Item * itemset, int level ) 
 {
 
 	return includedIn( children, itemset, level, 0 ) ;
 
 }
 
-bool Trie::includedIn( vector< short unsigned > * itemset ) 
+template< class Item >
+bool Trie< Item >::includedIn( vector< Item > * itemset ) 
 {
 
 	return includedIn( children, itemset, 0 ) ;
 
 }
 
-bool Trie::includedIn( list< short unsigned > * itemset ) 
+template< class Item >
+bool Trie< Item >::includedIn( list< Item > * itemset ) 
 {
 
 	return includedIn( children, itemset, itemset->begin() ) ;
@@ -108,7 +171,8 @@ bool Trie::includedIn( list< short unsigned > * itemset )
 *  be carefull itemset MUST BE ordered
 */
 
-bool Trie::includedIn( set<Trie> * items, short unsigned * itemset, int level, int spos ) 
+template< class Item >
+bool Trie< Item >::includedIn( set<Trie> * items, Item * itemset, int level, int spos ) 
 {
 	bool res = false ; // result of the inclusion test
 	
@@ -116,7 +180,7 @@ bool Trie::includedIn( set<Trie> * items, short unsigned * itemset, int level, i
 
 	int tmp ;
 
-	set< Trie >::iterator runner ;
+	typename set< Trie >::iterator runner ;
 
 	if( items != 0 )
 	{
@@ -168,7 +232,8 @@ bool Trie::includedIn( set<Trie> * items, short unsigned * itemset, int level, i
 
 }
 
-bool Trie::includedIn( set<Trie> * items, vector< short unsigned > * itemset, int spos ) 
+template< class Item >
+bool Trie< Item >::includedIn( set<Trie> * items, vector< Item > * itemset, int spos ) 
 {
 	bool res = false ; // result of the inclusion test
 	
@@ -176,7 +241,7 @@ bool Trie::includedIn( set<Trie> * items, vector< short unsigned > * itemset, in
 	
 	int tmp ;
 
-	set< Trie >::iterator runner ;
+	typename set< Trie >::iterator runner ;
 
 	if( items != 0 )
 	{
@@ -227,15 +292,16 @@ bool Trie::includedIn( set<Trie> * items, vector< short unsigned > * itemset, in
 
 }
 
-bool Trie::includedIn( set<Trie> * items, list< short unsigned > * itemset, list< short unsigned >::iterator spos ) 
+template< class Item >
+bool Trie< Item >::includedIn( set<Trie> * items, list< Item > * itemset, typename list< Item >::iterator spos ) 
 {
 	bool res = false ; // result of the inclusion test
 	
 	bool find ;
 	
-	list< short unsigned >::iterator tmp ;
+	typename list< Item >::iterator tmp ;
 
-	set< Trie >::iterator runner ;
+	typename set< Trie >::iterator runner ;
 
 	if( items != 0 )
 	{
@@ -288,17 +354,66 @@ bool Trie::includedIn( set<Trie> * items, list< short unsigned > * itemset, list
 
 // ---------------------------------------------------------------------------------------------- 
 
+/**
+*  method searching if one itemset of items including
+*  the item itemset[ mpos ] is included into itemset
+*  the itemsets are ordered so the sub trees of the items
+*  greater than itemset[ mpos ] are skipped until this
+*  item is found
+*  be carefull itemset MUST BE ordered
+*/
+
+template< class Item >
+bool Trie< Item >::includedInWith( set<Trie> * items, vector< Item > * itemset, int mpos, int spos ) 
+{
+	bool res = false ; // result of the inclusion test
+
+	int end ;	// end of the items of itemset that can be used
+
+	typename set< Trie >::iterator runner ;
+
+	if( ( items == 0 ) || items->empty() )
+		// we have check all the item of the current itemset
+		// of this set, it is kept only if it has itemset[ mpos ]
+		return ( spos > mpos ) ;
+
+	end = ( spos <= mpos ) ? mpos + 1 : itemset->size() ;
+
+	runner = items->begin() ;
+
+	while( ( res == false ) && ( runner != items->end() ) && ( spos < end ) )
+	{
+		// the children and itemset are ordered so we skip
+		// the items of itemset smaller than the id of the
+		// current child
+
+		while( ( spos < end ) && ( (*itemset)[ spos ] < runner->getId() ) )
+			spos++ ;
+
+		if( ( spos < end ) && ( (*itemset)[ spos ] == runner->getId() ) )
+			res = includedInWith( runner->getChildren(), itemset, mpos, spos + 1 ) ;
+
+		runner++ ;
+	}
+
+	return res ;
+
+}
+
+// ---------------------------------------------------------------------------------------------- 
+
 /**
 *  method searching if itemset is include in one
 *  of the itemsets of this set of itemset
 */
 
-bool Trie::include( set<Trie> * items, vector< short unsigned > * itemset, int spos ) 
+template< class Item >
+bool Trie< Item >::include( set<Trie> * items, vector< Item > * itemset, int spos ) 
 {
 
 	bool res = false ; // result of the inclusion test
 	
-	set< Trie >::iterator runner ;
+	typename set< Trie >::iterator runner ;
 
 	if( ( items != 0 ) && ( spos != itemset->size() ) )
 	{
@@ -341,12 +456,13 @@ bool Trie::include( set<Trie> * items, vector< short unsigned > * itemset, int s
 
 
 
-bool Trie::include( set<Trie> * items, short unsigned * itemset, int size, int spos ) 
+template< class Item >
+bool Trie< Item >::include( set<Trie> * items, Item * itemset, int size, int spos ) 
 {
 
 	bool res = false ; // result of the inclusion test
 	
-	set< Trie >::iterator runner ;
+	typename set< Trie >::iterator runner ;
 
 	if( ( items != 0 ) && ( spos != size ) )
 	{
@@ -389,134 +505,102 @@ bool Trie::include( set<Trie> * items, short unsigned * itemset, int size, int s
 // ---------------------------------------------------------------------------------------------- 
 
 /**
-*  print to screen all the itemset stored in tree
+*  functor printing an itemset and its support to screen
 *  remap is a table for mapping the name of the items
 */
 
-void Trie::printItemsets( short unsigned * remap )  
+template< class Item >
+struct ItemsetPrinter
 {
-	vector< short unsigned > * vect ;
+	OutputSink & sink ;
 
-	vect = new vector<short unsigned>() ;
+	ItemsetPrinter( OutputSink & inSink ) : sink( inSink ) {}
 
-	if( children != 0 )
-		printItemsets( remap, children , vect ) ;
-	
-	delete vect ;
-}
-
-void Trie::printItemsets( short unsigned * remap, set< Trie > * items, vector< short unsigned > * vect, int inSup ) 
-{
-
-	if( ( items != 0 ) && ( !items->empty() ) )
+	void operator()( vector< Item > * vect, Trie< Item > * node )
 	{
+		for( int j = 0; j < vect->size() ; j++ )
+			sink.putItem( (*vect)[ j ] ) ;
 
-		for(set< Trie >::iterator runner = items->begin(); runner != items->end(); runner++ )
-		{
-			
-			// we save the curent item of the itemset being processed
+		sink.putText( " size ( " ) ;
+		sink.putNumber( vect->size() ) ;
+		sink.putText( " )   support ( " ) ;
+		sink.putNumber( node->getSupport() ) ;
+		sink.putText( " )\n" ) ;
+	}
+};
 
-			vect->push_back( runner->getId() ) ;
-			
-			inSup = runner->getSupport() ;
+/**
+*  print to screen all the itemset stored in tree
+*  remap is a table for mapping the name of the items
+*  ( cout is flushed before, the itemsets are written
+*  on the standard output through a buffer )
+*/
 
-			// we continue searching with the next items
+template< class Item >
+void Trie< Item >::printItemsets( int * remap )  
+{
+	OutputSink sink ;
 
-			printItemsets( remap, runner->getChildren(), vect, inSup ) ;
+	ItemsetPrinter< Item > printer( sink ) ;
 
-			vect->pop_back() ;
-				
-		}
+	cout.flush() ;
 
-	}
-	else	// we have check all the items of the current itemset strored in vect
-			// so we print to screen
-	{
-		
-		for( int j = 0; j < vect->size() ; j++ )
-		{
-			if(remap)  
-				cout<< remap[ (*vect)[ j ] ]<<" " ; 
-			else 
-				cout<< (*vect)[ j ]<<" " ;  
-	
-		}
-		cout<<" size ( "<<vect->size() <<" ) " ;
-		cout<<"  support ( "<< inSup<<" )"<<endl ;		
+	sink.attach( 1 ) ;
 
-	}
+	sink.setRemap( remap ) ;
+
+	visitItemsets( this, printer ) ;
 
+	sink.close() ;
 }
 
 // ---------------------------------------------------------------------------------------------- 
 
 /**
-*  save into a file all the itemset stored in tree
+*  functor writing an itemset and its support into a file
 *  remap is a table for mapping the name of the items
 *  if remap is 0 it use the internal id
 */
 
-void Trie::saveItemsets( const char * fileName, short unsigned * remap ) 
+template< class Item >
+struct ItemsetWriter
 {
+	OutputSink & sink ;
 
-	ofstream pFile( fileName ) ;
-
-	vector< short unsigned > * vect ;
+	ItemsetWriter( OutputSink & inSink ) : sink( inSink ) {}
 
-	vect = new vector<short unsigned>() ;
-
-	if( pFile.is_open() )
+	void operator()( vector< Item > * vect, Trie< Item > * node )
 	{
-		if( children != 0 )
-			saveItemsets( pFile, remap, children, vect) ;
+		for( int j = 0; j < vect->size() ; j++ )
+			sink.putItem( (*vect)[ j ] ) ;
 
-		pFile.close()  ;
+		sink.putChar( '(' ) ;
+		sink.putNumber( node->getSupport() ) ;
+		sink.putText( ")\n" ) ;
 	}
+};
 
-	delete vect ;
-
-}
+/**
+*  save into a file all the itemset stored in tree
+*  remap is a table for mapping the name of the items
+*  if remap is 0 it use the internal id
+*/
 
-void Trie::saveItemsets( ofstream & pFile, short unsigned * remap, set< Trie > * items, vector< short unsigned > * vect
-						, int inSup ) 
+template< class Item >
+void Trie< Item >::saveItemsets( const char * fileName, int * remap, SinkMode mode ) 
 {
 
-	if( ( items != 0 ) && ( !items->empty() ) )
-	{
-
-		for(set< Trie >::iterator runner = items->begin(); runner != items->end(); runner++ )
-		{
-			
-			// we save the curent item of the itemset being processed
-
-			vect->push_back( runner->getId() ) ;
-
-			inSup = runner->getSupport() ;
+	OutputSink sink ;
 
-			// we continue searching with the next items
+	if( sink.open( fileName, mode ) )
+	{
+		ItemsetWriter< Item > writer( sink ) ;
 
-			saveItemsets( pFile, remap, runner->getChildren(), vect, inSup ) ;
+		sink.setRemap( remap ) ;
 
-			vect->pop_back() ;
-				
-		}
+		visitItemsets( this, writer ) ;
 
-	}
-	else	// we have check all the items of the current itemset strored in vect
-			// so we write into the file
-	{
-		
-		for( int j = 0; j < vect->size() ; j++ )
-		{
-			if(remap) 
-				pFile<< remap[ (*vect)[ j ] ]<<" " ; 
-			else 
-				pFile<< (*vect)[ j ] <<" " ; 
-	
-		}
-		pFile<<"("<< inSup<<")"<<endl;
-	
-	
+		sink.close()  ;
 	}
 
 }
@@ -529,79 +613,50 @@ void Trie::saveItemsets( ofstream & pFile, short unsigned * remap, set< Trie > *
 *  according the FIMI format of datasets 
 */
 
-void Trie::saveDataSet( const char * fileName, short unsigned * remap ) 
+template< class Item >
+void Trie< Item >::saveDataSet( const char * fileName, int * remap ) 
 {
 
-	ofstream pFile( fileName ) ;
+	OutputSink sink ;
 
-	list< unsigned >  * lst ;
+	vector< Item > trans ;
 
-	lst = new list<unsigned>() ;
-
-	if( pFile.is_open() )
+	if( sink.open( fileName ) )
 	{
-		if( children != 0 )
-			saveDataSet( pFile, remap, children, lst ) ;
-
-		pFile.close()  ;
-	}
-
-	delete lst ;
-
-}
-
-void Trie::saveDataSet( ofstream & pFile, short unsigned * remap, set< Trie > * items, list< unsigned >  * lst ) 
-{
+		TrieIterator< Item > it( this ) ;
 
-	if( ( items != 0 ) && ( !items->empty() ) )
-	{
+		sink.setRemap( remap ) ;
 
-		for(set< Trie >::iterator runner = items->begin(); runner != items->end(); runner++ )
+		while( it.next() )
 		{
-			
-			// we save the curent item of the itemset being processed
-
-			lst->push_back( remap[ runner->getId() ] ) ;
+			trans = *it.getItemset() ;
 
-			// we continue searching with the next items
-
-			saveDataSet( pFile, remap, runner->getChildren(), lst ) ;
-
-			lst->pop_back() ;
-				
-		}
+			// the itemset are ordered wrt their name
+			sort( trans.begin(), trans.end(), [ remap ]( Item a, Item b ) { return remap[ a ] < remap[ b ] ; } ) ;
 
-	}
-	else	// we have check all the items of the current itemset strored in vect
-			// so we write into the file
-	{
-		// the itemset are ordered wrt their name
-		lst->sort() ;	
+			for( int j = 0; j < trans.size() ; j++ )
+				sink.putItem( trans[ j ] ) ;
 
-		for( list< unsigned >::iterator it = lst->begin(); it != lst->end(); lst++ )
-		{
-			pFile<< *it <<" " ;
-			
+			sink.putChar( '\n' ) ;
 		}
-		pFile<<endl;
 
-	
+		sink.close()  ;
 	}
 
 }
-
 // ---------------------------------------------------------------------------------------------- 
 
 /**
 *  method which insert an itemset in a set of itemset
 */
 
-void Trie::insert( short unsigned * itemset, int level, int inSup ) 
+template< class Item >
+void Trie< Item >::insert( Item * itemset, int level, int inSup ) 
 {
 
 	set< Trie > * tmpSet ;
 
-	set< Trie >::iterator runner ;
+	typename set< Trie >::iterator runner ;
 	
 	int i = 0 ;	
 
@@ -645,12 +700,13 @@ void Trie::insert( short unsigned * itemset, int level, int inSup )
 
 }
 
-void Trie::insert( vector< short unsigned > * itemset, int inSup ) 
+template< class Item >
+void Trie< Item >::insert( vector< Item > * itemset, int inSup ) 
 {
 
 	set< Trie > * tmpSet ;
 
-	set< Trie >::iterator runner ;
+	typename set< Trie >::iterator runner ;
 	
 	int i = 0 ;
 
@@ -695,18 +751,19 @@ void Trie::insert( vector< short unsigned > * itemset, int inSup )
 
 }
 
-void Trie::insert( list< short unsigned > * itemset, int inSup ) 
+template< class Item >
+void Trie< Item >::insert( list< Item > * itemset, int inSup ) 
 {
 
 	set< Trie > * tmpSet ;
 
-	set< Trie >::iterator runner ;
+	typename set< Trie >::iterator runner ;
 	
 	int i = 0 ;
 
 	tmpSet = children ;
 
-	list< short unsigned >::iterator it;
+	typename list< Item >::iterator it;
 
 	it = itemset->begin() ;
 
@@ -728,7 +785,7 @@ void Trie::insert( list< short unsigned > * itemset, int inSup )
 
 	// insertion of the part of the itemset not already stored in itSet
 
-	for( list< short unsigned >::iterator it2 = it; it2 != itemset->end(); it2++ )
+	for( typename list< Item >::iterator it2 = it; it2 != itemset->end(); it2++ )
 	{
 		if( children == 0 )
 		{
@@ -755,17 +812,19 @@ void Trie::insert( list< short unsigned > * itemset, int inSup )
 *  method which delete an itemset in a set of itemset
 */
 
-void Trie::deleteIt( vector< short unsigned > * itemset  ) 
+template< class Item >
+void Trie< Item >::deleteIt( vector< Item > * itemset  ) 
 {
 
 	deleteIt( itemset, children ) ;	
 
 }
 
-int Trie::deleteIt( vector< short unsigned > * itemset, set< Trie > * items, int pos ) 
+template< class Item >
+int Trie< Item >::deleteIt( vector< Item > * itemset, set< Trie > * items, int pos ) 
 {
 
-	set< Trie >::iterator runner ;
+	typename set< Trie >::iterator runner ;
 	
 	
 	if( ( items != 0 ) && ( pos < itemset->size() ) )
@@ -783,9 +842,6 @@ int Trie::deleteIt( vector< short unsigned > * itemset, set< Trie > * items, int
 			if( ( pos == itemset->size() ) && 
 				( ( runner->getChildren() == 0 ) || ( (runner->getChildren())->empty() ) ) )
 			{
-			    Trie * tmpT = const_cast< Trie * >( &(*runner) ) ;
-				tmpT->deleteChildren() ;
-
 				items->erase( runner ) ;
 			}
 
@@ -820,513 +876,333 @@ int Trie::deleteIt( vector< short unsigned > * itemset, set< Trie > * items, int
 *        of Ei+1, bi is Bi  
 */  
 
-void Trie::initTrBi( short unsigned * itemset, int level,  Trie * bi ) 
+template< class Item >
+void Trie< Item >::initTrBi( Item * itemset, int level,  Trie * bi ) 
 {
-	vector< short unsigned > * vect ;
-
-	vect = new vector<short unsigned>() ;
-
-	initTrBi( children, itemset, level, bi, vect ); 
-
-	// number of element of trie now
-
-	support = support - bi->support ;
-	
-	delete vect ;
-
-}
+	TrieIterator< Item > it( this ) ;
 
-void Trie::initTrBi( vector< short unsigned > * itemset,  Trie * bi ) 
-{
-	vector< short unsigned > * vect ;
+	while( it.next() )
+	{
+		// if there is no intersection we move
+		// the itemset from Tr(i+1) to Bi
 
-	vect = new vector<short unsigned>() ;
+		if( intersects( it.getItemset(), itemset, level ) == false )
+		{
+			bi->insert( it.getItemset() ) ;
 
-	initTrBi( children, itemset, bi, vect ); 
+			it.erase() ;
+		}
+	}
 
 	// number of element of trie now
 
 	support = support - bi->support ;
-	
-	delete vect ;
 
 }
 
-bool Trie::initTrBi( set< Trie > * items, short unsigned * itemset, int level, Trie  * bi, vector< short unsigned > * vect ) 
+template< class Item >
+void Trie< Item >::initTrBi( vector< Item > * itemset,  Trie * bi ) 
 {
+	if( itemset->empty() )
+		initTrBi( (Item *) 0, 0, bi ) ;
+	else
+		initTrBi( &(*itemset)[ 0 ], itemset->size(), bi ) ;
+}
 
-	bool intersect = true ; // variable returning if the intersection is null or not
-
-	bool res ;	// variable used to search an intersection
+// ---------------------------------------------------------------------------------------------- 
 
-	int i ;
+/**
+*  method that test if the itemset vect and the itemset
+*  "itemset" of size "level" have a common item
+*  the two itemsets are ordered so they are scanned only once
+*/
 
-	set< Trie >::iterator runner ;
+template< class Item >
+bool Trie< Item >::intersects( vector< Item > * vect, Item * itemset, int level ) 
+{
+	int i = 0 ;
 
-	set< Trie >::iterator tmp ;
+	int j = 0 ;
 
-	if( items != 0 )
+	while( ( i < vect->size() ) && ( j < level ) )
 	{
+		if( (*vect)[ i ] < itemset[ j ] )
+			i++ ;
+		else if( (*vect)[ i ] > itemset[ j ] )
+			j++ ;
+		else
+			return true ;
+	}
 
-		for( runner = items->begin(); runner != items->end(); )
-		{
-			intersect = true ;
-			res = false ;
-			i = 0 ;
-
-			// we search if there is an intersection
-
-			while( ( res == false ) && ( i < level ) )
-			{
-				if( runner->getId() == itemset[ i ] )
-					res = true ;
-
-				i++ ;
-			}
+	return false ;
+}
 
-			if( res == false ) // we continue searching if the next
-							   // items of the current motif intersect itemset
-			{
-				// we save the curent item of the itemset being processed
+// ---------------------------------------------------------------------------------------------- 
 
-				vect->push_back( runner->getId() ) ;
+/**
+*  method which construct 
+*  Tr(i+1) = Si with Tr mininmal transversal
+*  				and Si = { X is in Tr(i) | X intersect Ei+1 != 0 }
+*  				and H = { E1,..., En } an hypergraph
+*  and Bi with Bi = { X is in Tr(i) | X intersect Ei+1 == 0 }
+*  Note: here Tr(i) is items, Ei+1 is itemset, level is the size
+*        of Ei+1, bi is Bi  
+*  this method is optimised for our problem since it don't add
+*  to Bi the transversal of cardinality >= n-k-1 
+*                        with n the number of items and
+*                        k the actual level of the levelwise approach  
+*/
 
-				// we continue searching with the next items
+template< class Item >
+void Trie< Item >::initTrBiOpt( vector< Item > * itemset,  Trie * bi, int n, int k  )
+{
+	// the nodes at depth n-k are processed as leaves,
+	// ie the transversals of cardinality >= n-k are deleted
 
-				intersect = initTrBi( runner->getChildren(), itemset, level, bi, vect ) ;
+	TrieIterator< Item > it( this, ( n-k > 0 ) ? n-k : 0 ) ;
 
-				// if there is no intersection 
-				// we delete the motif from Tr(i+1)
+	vector< Item > * vect ;
 
-				if( ( intersect == false ) && 
-					( ( runner->getChildren() == 0 ) || ( (runner->getChildren())->empty() ) ) )
-				{
-					Trie * tmpT = const_cast< Trie * >( &(*runner) ) ;
-				tmpT->deleteChildren() ;
+	int level = itemset->size() ;
 
-					tmp = runner ++ ;
+	Item * items = level ? &(*itemset)[ 0 ] : 0 ;
 
-					items->erase( tmp ) ;
-				}
-				else
-					runner++ ;
+	while( it.next() )
+	{
+		vect = it.getItemset() ;
 
-				vect->pop_back() ;
-			}
-			else
-				runner++ ;
+		if( (int)vect->size() >= n-k )
+		{
+			support-- ;
 
+			it.erase() ;
 		}
+		else if( intersects( vect, items, level ) == false )
+		{
+			// we move the itemset from Tr(i+1) to Bi
 
-	}
-	else	// we have check all the items of the current itemset strored in vect
-			// and there is no intersection. so we add this itemset to Bi
-	{
-		intersect = false ;
+			if( (int)vect->size() < n-k-1 ) 
+				bi->insert( vect ) ;
 
-		bi->insert( vect ) ;
+			support-- ;
 
+			it.erase() ;
+		}
 	}
-
-	return intersect ;
 }
 
-bool Trie::initTrBi( set< Trie > * items, vector< short unsigned > * itemset, Trie  * bi, vector< short unsigned > * vect ) 
-{
 
-	bool intersect = true ; // variable returning if the intersection is null or not
+// ---------------------------------------------------------------------------------------------- 
+
+/**
+*  method generating into res the new itemsets for Tr(i+1)
+*  with Tr(i), the itemsets of bi and the new edge itemset,
+*  bi is consumed ( see newItTr )
+*  be carefull itemset MUST BE ordered
+*/
 
-	bool res ;	// variable used to search an intersection
+template< class Item >
+void Trie< Item >::genItTr( Trie * bi, Item * itemset, int level, SubsetIndex< Item > * freqTr, Trie * res ) 
+{	
+	vector< Item > * vect ;
 
-	int i ;
+	vector< Item > cand ;	// candidate, ie an itemset of Bi plus one item
+							// of the edge, with a free place at pos
 
-	set< Trie >::iterator runner ;
+	int pos ;
 
-	set< Trie >::iterator tmp ;
+	if( ( freqTr != 0 ) && freqTr->empty() )
+		freqTr = 0 ;
 
-	if( items != 0 )
+	if( ( bi->getChildren() != 0 ) && ( children != 0 ) )
 	{
+		TrieIterator< Item > it( bi ) ;
 
-		for( runner = items->begin(); runner != items->end(); )
+		while( it.next() ) // we have one itemset of Bi
 		{
-			intersect = true ;
-			res = false ;
-			i = 0 ;
+			vect = it.getItemset() ;
 
-			// we search if there is an intersection
+			cand.resize( vect->size() + 1 ) ;
 
-			while( ( res == false ) && ( i < itemset->size() ) )
-			{
-				if( runner->getId() == (*itemset)[ i ] ) 
-					res = true ;
+			copy( vect->begin(), vect->end(), cand.begin() + 1 ) ;
 
-				i++ ;
-			}
+			pos = 0 ;
 
-			if( res == false ) // we continue searching if the next
-							   // items of the current motif intersect itemset
+			for( int i = 0; i < level ; i++ )
 			{
-				// we save the curent item of the itemset being processed
-
-				vect->push_back( runner->getId() ) ;
+				// we generate a new candidate which might be in the minimal transversal,
+				// the items of the edge are ordered so the free place only goes forward
 
-				// we continue searching with the next items
+				while( ( pos < vect->size() ) && ( (*vect)[ pos ] < itemset[ i ] ) )
+				{
+					cand[ pos ] = (*vect)[ pos ] ;
+					pos++ ;
+				}
 
-				intersect = initTrBi( runner->getChildren(), itemset, bi, vect ) ;
+				cand[ pos ] = itemset[ i ] ;
 
-				// if there is no intersection 
-				// we delete the motif from Tr(i+1)
+				// we test that all the itemsets of Si are not inluded into our candidate,
+				// an itemset of Bi has no item of the edge so an itemset of Si
+				// ( which intersects the edge ) included into the candidate
+				// has the new item, only these itemsets are searched
+				// it is the same for freqTr since no itemset of Bi includes
+				// one of its itemsets ( they were transversals of the
+				// same antichain or the candidates were tested against them )
 
-				if( ( intersect == false ) && 
-					( ( runner->getChildren() == 0 ) || ( (runner->getChildren())->empty() ) ) )
+				if( ( includedInWith( children, &cand, pos ) == false )
+					&& ( ( freqTr == 0 ) || ( freqTr->includedInWith( &cand, pos ) == false ) ) )
 				{
-					Trie * tmpT = const_cast< Trie * >( &(*runner) ) ;
-					tmpT->deleteChildren() ;
-
-					tmp = runner ++ ;
-
-					items->erase( tmp ) ;
+					res->insert( &cand ) ;
 				}
-				else
-					runner++ ;
-
-				vect->pop_back() ;
 			}
-			else
-				runner++ ;
 
-		}
-
-	}
-	else	// we have check all the items of the current itemset strored in vect
-			// and there is no intersection. so we add this itemset to Bi
-	{
-		intersect = false ;
-
-		bi->insert( vect ) ;
+			// Bi is consumed while the new itemsets are generated
 
+			it.erase() ;
+		}
 	}
-
-	return intersect ;
 }
 
 // ---------------------------------------------------------------------------------------------- 
 
 /**
-*  method which construct 
-*  Tr(i+1) = Si with Tr mininmal transversal
-*  				and Si = { X is in Tr(i) | X intersect Ei+1 != 0 }
-*  				and H = { E1,..., En } an hypergraph
-*  and Bi with Bi = { X is in Tr(i) | X intersect Ei+1 == 0 }
-*  Note: here Tr(i) is items, Ei+1 is itemset, level is the size
-*        of Ei+1, bi is Bi  
-*  this method is optimised for our problem since it don't add
-*  to Bi the transversal of cardinality >= n-k-1 
-*                        with n the number of items and
-*                        k the actual level of the levelwise approach  
+*  method generating the new itemsets for Tr(i+1) with 
+*  Tr(i), Bi, the new edge itemset
+*  this method is optimised for our problem since it 
+*  enable the separation of the minimal transversals
+*  that "generate" frequent already tested ("freqTr") from the 
+*  others, without affecting the process of the 
+*  minimals transversals
+*  the itemsets of Bi are processed independently, only Si
+*  and freqTr are read by all, so when Bi is large enough the
+*  sub trees of Bi are shared between nbThreads threads, each
+*  one with its own result, and the results are merged in the
+*  order of the threads
+*  be carefull itemset MUST BE ordered
 */
 
-void Trie::initTrBiOpt( vector< short unsigned > * itemset,  Trie * bi, int n, int k  )
-{
-	vector< short unsigned > * vect ;
-
-	bool intersect = false ; // variable returning if the intersection is null or not
+template< class Item >
+Trie< Item > * Trie< Item >::newItTr( Trie * bi, Item * itemset, int level, SubsetIndex< Item > * freqTr, int nbThreads ) 
+{	
+	Trie * res = new Trie( 0 ) ;
 
-	vect = new vector<short unsigned>() ;
+	set< Trie > * biChild = bi->getChildren() ;
 
-	initTrBiOpt( children, itemset, bi, vect, intersect, n, k ); 
-	
-	delete vect ;
+	vector< unsigned int > count ;	// number of itemsets of each sub tree of Bi
 
-}
+	vector< unsigned int > order ;	// sub trees by decreasing number of itemsets
 
+	vector< unsigned int > load ;	// number of itemsets given to each thread
 
-bool Trie::initTrBiOpt( set< Trie > * items, vector< short unsigned > * itemset,Trie * bi,
-					   vector< short unsigned > * vect, bool intersect,  int n, int k )
-{
+	vector< int > owner ;			// thread of each sub tree
 
-	bool oldInter ;
+	vector< Trie * > parts ;		// part of Bi and result of each thread
 
-	int i ;
+	vector< Trie * > results ;
 
-	set< Trie >::iterator runner ;
+	vector< thread > workers ;
 
-	set< Trie >::iterator tmp ;
+	typename set< Trie >::iterator runner ;
 
-	if( ( items != 0 ) && ( vect->size() < n-k ) )
-	{
+	int t, g ;
 
-		oldInter = intersect; 
+	if( ( biChild == 0 ) || ( children == 0 ) )
+		return res ;
 
-		for( runner = items->begin(); runner != items->end(); )
-		{			
+	if( ( nbThreads < 2 ) || ( biChild->size() < 2 ) 
+		|| ( (unsigned long)bi->getSupport() * level < MIN_PARALLEL_CANDIDATES ) )
+	{
+		genItTr( bi, itemset, level, freqTr, res ) ;
 
-			intersect = oldInter ;
+		return res ;
+	}
 
-			i = 0 ;
+	// number of itemsets of each sub tree, the itemsets
+	// are given in the order of the first item
 
-			// we search if there is an intersection
+	count.assign( biChild->size(), 0 ) ;
 
-			while( ( i < itemset->size() ) && ( runner->getId() >= (*itemset)[ i ] ) ) 
-			{
-				if( runner->getId() == (*itemset)[ i ] ) 
-					intersect = true ;
+	runner = biChild->begin() ;
 
-				i++ ;
-			}
-			
-			// we save the curent item of the itemset being processed
+	g = 0 ;
 
-			vect->push_back( runner->getId() ) ;
-					
-			// we continue searching with the next items
+	TrieIterator< Item > it( bi ) ;
 
-			intersect = initTrBiOpt( runner->getChildren(), itemset, bi, vect, intersect, n, k ) ;
-
-			// if there is no intersection 
-			// we delete the motif from Tr(i+1)
-
-			if( ( intersect == false ) && 
-				( ( runner->getChildren() == 0 ) || ( (runner->getChildren())->empty() ) ) )
-			{
-				Trie * tmpT = const_cast< Trie * >( &(*runner) ) ;
-				tmpT->deleteChildren() ;
-
-				tmp = runner ++ ;
-
-				items->erase( tmp ) ;
-			}
-			else
-				runner++ ;
-
-			vect->pop_back() ;
-
-		
-
-		}
-		
-	
-
-	}
-	else	// we have check all the items of the current itemset strored in vect
-			// and there is no intersection. so we add this itemset to Bi
+	while( it.next() )
 	{
-		
-		if ( vect->size() >= n-k )
-		{
-			intersect = false ;
-			support--;
-		}
-		else
+		while( runner->getId() != (*it.getItemset())[ 0 ] )
 		{
-			if(   intersect == false ) 
-			{
-			    if( vect->size() < n-k-1 ) 
-						bi->insert( vect ) ;
-
-					support--;
-				}
-
+			runner++ ;
+			g++ ;
 		}
-		
 
+		count[ g ]++ ;
 	}
 
-	return intersect ;
-}
-
-
-// ---------------------------------------------------------------------------------------------- 
+	// the biggest sub trees are given first, each
+	// one to the thread with the less itemsets
 
-/**
-*  method generating the new itemsets for Tr(i+1) with 
-*  Tr(i), Bi, the new edge itemset
-*/
+	if( nbThreads > biChild->size() )
+		nbThreads = biChild->size() ;
 
-Trie * Trie::newItTr( Trie * bi, short unsigned * itemset, int level ) 
-{	
+	for( g = 0; g < count.size() ; g++ )
+		order.push_back( g ) ;
 
-	Trie * res ;
+	stable_sort( order.begin(), order.end(), [ &count ]( unsigned int a, unsigned int b ) { return count[ a ] > count[ b ] ; } ) ;
 
-	list< short unsigned > * lst ;
-		
-	res = new Trie( 0 ) ;
+	load.assign( nbThreads, 0 ) ;
+	owner.assign( count.size(), 0 ) ;
 
-	if( bi->getChildren() != 0 )
+	for( g = 0; g < order.size() ; g++ )
 	{
-		lst = new list< short unsigned >() ;
+		t = min_element( load.begin(), load.end() ) - load.begin() ;
 
-		newItTr( children, bi->getChildren(), itemset, level, lst, res ) ;
-
-		delete lst ;
+		owner[ order[ g ] ] = t ;
+		load[ t ] += count[ order[ g ] ] ;
 	}
 
-	return res ;
-	
-}
-
-void Trie::newItTr( set< Trie > * trs, set< Trie > * bis, short unsigned * itemset, int level,
-						  list< short unsigned > * lst, Trie * res ) 
-{
-
-	set< Trie >::iterator runner, tmp ;
-
-	list< short unsigned >::iterator tmpl ;
+	// the sub trees are moved ( not copied ) to the part of
+	// their thread, in order so they are inserted at the end
 
-	
-	if( bis != 0 ) // we go throw the tree to an itemset
+	for( t = 0; t < nbThreads ; t++ )
 	{
+		parts.push_back( new Trie( 0 ) ) ;
+		results.push_back( new Trie( 0 ) ) ;
 
-		for( runner = bis->begin(); runner != bis->end();  )
-		{		
-			lst->push_back( runner->getId() ) ;
-
-			newItTr( trs, runner->getChildren() , itemset, level , lst, res ) ;
-
-			lst->pop_back() ;
-
-			tmp = runner ++ ;
-
-			bis->erase( tmp ) ;
-
-		}
-
-		delete bis;
-
+		parts[ t ]->makeChildren() ;
 	}
-	else // we have one itemset of Bi	
-	{
-
-		for( int i = 0; i < level ; i++ )
-		{
-			// we generate a new candidate which might be in the minimal transversal
-
-			lst->push_back( itemset[ i ] ) ;
-
-			// we keep an iterator on the item that
-			// we have just inserted
-
-			tmpl = lst->end() ;
-			tmpl-- ;
 
-			lst->sort() ;
+	g = 0 ;
 
-			// we test that all the itemsets of Si are not inluded into our candidate
-
-			if ( includedIn(trs, lst, lst->begin() ) == false )
-			{
-				res->insert( lst ) ;
-			}
-
-			lst->erase( tmpl ) ;
-
-		}
+	for( runner = biChild->begin(); runner != biChild->end(); g++ )
+	{
+		typename set< Trie >::iterator tmp = runner++ ;
 
+		parts[ owner[ g ] ]->children->insert( parts[ owner[ g ] ]->children->end(), biChild->extract( tmp ) ) ;
 	}
 
-}
-
-// ---------------------------------------------------------------------------------------------- 
-
-/**
-*  method generating the new itemsets for Tr(i+1) with 
-*  Tr(i), Bi, the new edge itemset
-*  this method is optimised for our problem since it 
-*  enable the separation of the minimal transversals
-*  that "generate" frequent already tested ("freqTr") from the 
-*  others, without affecting the process of the 
-*  minimals transversals
-*/
-
-Trie * Trie::newItTr( Trie * bi, vector< short unsigned > * itemset, Trie * freqTr ) 
-{
-	Trie * res ;
-
-	list< short unsigned > * lst ;
+	bi->setSupport( 0 ) ;
 
-	res = new Trie( 0 ) ;
+	for( t = 0; t < nbThreads ; t++ )
+		workers.push_back( thread( &Trie::genItTr, this, parts[ t ], itemset, level, freqTr, results[ t ] ) ) ;
 
-	if( bi->getChildren() != 0 )
+	for( t = 0; t < nbThreads ; t++ )
 	{
-		lst = new list< short unsigned >() ;
+		workers[ t ].join() ;
 
-		if( freqTr != 0 )
-			newItTr( children, bi->getChildren(), itemset, lst, res, freqTr->getChildren() ) ;
-		else
-			newItTr( children, bi->getChildren(), itemset, lst, res ) ;
+		res->merge( results[ t ] ) ;
 
-
-		delete lst ;
-		
+		delete results[ t ] ;
+		delete parts[ t ] ;
 	}
-	
-
-	return res ;	
 
+	return res ;
 }
 
-void  Trie::newItTr( set< Trie > * trs, set< Trie > * bis, vector< short unsigned > * itemset,
-						  list< short unsigned > * lst, Trie * res, set< Trie > * freqTrChild ) 
+template< class Item >
+Trie< Item > * Trie< Item >::newItTr( Trie * bi, vector< Item > * itemset, SubsetIndex< Item > * freqTr, int nbThreads ) 
 {
-	
-	set< Trie >::iterator runner,tmp ;
-
-	list< short unsigned >::iterator tmpl ;
-
-	
-	if( bis != 0 ) // we go throw the tree to an itemset
-	{
-
-		for( runner = bis->begin(); runner != bis->end(); )
-		{		
-			lst->push_back( runner->getId() ) ;
-
-			newItTr( trs, runner->getChildren() , itemset , lst, res, freqTrChild ) ;
-
-			lst->pop_back() ;
-
-			tmp = runner ++ ;
-
-			bis->erase( tmp ) ;
-
-		}
-
-		delete bis;
-
-	}
-	else // we have one itemset of Bi	
-	{
-
-		for( int i = 0; i < itemset->size() ; i++ )
-		{
-			// we generate a new candidate which might be in the minimal transversal
-
-			lst->push_back( (*itemset)[ i ] ) ;
-
-			// we save the place of the item that
-			// we have just inserted
-
-			tmpl = lst->end() ;
-			tmpl-- ;
-
-			lst->sort() ;
-
-			// we test that all the itemsets of Si are not inluded into our candidate
-
-			if ( ( includedIn( trs, lst, lst->begin() ) == false )
-				 && ( ( freqTrChild == 0 ) || ( freqTrChild->empty() ) ||
-				      ( includedIn( freqTrChild, lst, lst->begin() ) == false ) ) )
-			{
-
-				res->insert( lst ) ;
-			}
-
-			lst->erase( tmpl ) ;
-
-		}
-
-	}
-
+	return newItTr( bi, itemset->empty() ? 0 : &(*itemset)[ 0 ], itemset->size(), freqTr, nbThreads ) ;
 }
 
 // ---------------------------------------------------------------------------------------------- 
@@ -1334,78 +1210,90 @@ void  Trie::newItTr( set< Trie > * trs, set< Trie > * bis, vector< short unsigne
 /**
 *  method merging the sets of itemset trie1
 *  and trie2 into the set trie 1 ( this )
-*  note: the set trie2 is destructed after the copy,
+*  note: the nodes of trie2 are moved (not copied) into trie1
+*  so trie2 is empty after the merge,
 *  the itemsets of trie1 are not included in trie2
 *  and the itemsets of trie2 are not included 
 *  in trie1
 */
 
-void Trie::merge( Trie * trie2 ) 
+template< class Item >
+void Trie< Item >::merge( Trie * trie2 ) 
 {
 
 	support = support + trie2->support ;
 
-	merge( children, trie2->getChildren() ) ;
+	mergeChildren( trie2 ) ;
 
-	trie2->setChildren( 0 ) ;
+	trie2->support = 0 ;
 			
 }
 
-void Trie::merge( set< Trie > * trieC1, set< Trie > * trieC2 ) 
+template< class Item >
+void Trie< Item >::mergeChildren( Trie * trie2 ) 
 {
 	
-	set< Trie >::iterator runner1 ;
+	typename set< Trie >::iterator runner1 ;
 
-	set< Trie >::iterator runner2 ;
+	typename set< Trie >::iterator runner2 ;
 
-	set< Trie >::iterator tmp ;	
+	typename set< Trie >::iterator tmp ;	
 
-	// we go throw the tree trie2 to an item that is not stored in trie1
+	set< Trie > * trieC2 = trie2->children ;
 
-	if( ( trieC1 != 0 ) && ( trieC2 != 0  ) )
+	if( trieC2 == 0 )
+		return ;
+
+	// if this node has no children we simply take the sub tree of trie2
+
+	if( ( children == 0 ) || ( children->empty() ) )
 	{
+		delete children ;
 
-		// we go throw all the childrens of trie1 
+		children = trie2->releaseChildren() ;
 
-		for( runner2 = trieC2->begin() ; runner2 != trieC2->end();  )
-		{		
-			
-			// we check if the current item is already in trie1
+		return ;
+	}
 
-			if( ( runner1 = trieC1->find( Trie( runner2->getId() ) ) ) != trieC1->end() )
-			{
-								
-				merge( runner1->getChildren(), runner2->getChildren() ) ;
-			
-			}
-			else // we have to insert the current item in trie1
-			{
-				// we insert this item not included in trieC1 and all these chilrens 
-				// in trie1, ie we insert the rest of the current itemset that is not 
-				// included in trie1, in trie2 				
+	// the two sets of children are ordered so we go throw them
+	// in the same time, each child of trie2 is compared only
+	// with the children of trie1 between the previous one and it
 
-				trieC1->insert( *runner2 ) ;
-				
-			}
+	runner1 = children->begin() ;
 
-			tmp = runner2 ++ ;
+	for( runner2 = trieC2->begin() ; runner2 != trieC2->end();  )
+	{		
+		while( ( runner1 != children->end() ) && ( runner1->getId() < runner2->getId() ) )
+			runner1++ ;
 
-			trieC2->erase( tmp ) ;
+		// we check if the current item is already in trie1
 
-		}
+		if( ( runner1 != children->end() ) && ( runner1->getId() == runner2->getId() ) )
+		{
+			Trie * tmpT1 = const_cast< Trie * >( &(*runner1) ) ;
+			Trie * tmpT2 = const_cast< Trie * >( &(*runner2) ) ;
 
-		delete trieC2 ;
-		trieC2 = 0 ;
-		
+			tmpT1->mergeChildren( tmpT2 ) ;
 
-	}
-	else
-		if( trieC2 != 0)
+			runner1++ ;
+			runner2++ ;
+		}
+		else // we have to insert the current item in trie1
 		{
-			trieC1 = trieC2 ;
-			trieC2 = 0 ;
+			// the node and all its childrens are moved from trie2
+			// to trie1 without copy, just before runner1 so the
+			// insertion is done in constant time
+
+			tmp = runner2 ++ ;
+
+			children->insert( runner1, trieC2->extract( tmp ) ) ;
 		}
-	
+
+	}
+
+	delete trieC2 ;
+
+	trie2->children = 0 ;
 
 }
 
@@ -1416,12 +1304,14 @@ void Trie::merge( set< Trie > * trieC1, set< Trie > * trieC2 )
 *  of size < "level"
 */
 
-int Trie::pruneNodes(int level)
+template< class Item >
+int Trie< Item >::pruneNodes(int level)
 {
   return pruneNodes( level, children, 1 );
 }
 
-int Trie::pruneNodes(int level, set<Trie> *items, int depth)
+template< class Item >
+int Trie< Item >::pruneNodes(int level, set<Trie> *items, int depth)
 {
   if(items == 0)
   {
@@ -1437,7 +1327,7 @@ int Trie::pruneNodes(int level, set<Trie> *items, int depth)
 	  nodes = items->size();
   else
   {
-    for(set<Trie>::iterator runner = items->begin(); runner != items->end(); )
+    for(typename set<Trie>::iterator runner = items->begin(); runner != items->end(); )
 	{
       int now = pruneNodes(level, runner->getChildren(), depth+1);
 
@@ -1451,10 +1341,7 @@ int Trie::pruneNodes(int level, set<Trie> *items, int depth)
 	  {
 		  // deletion of the itemsets of size != k
 
-		  Trie * tmpT = const_cast< Trie * >( &(*runner) ) ;
-				tmpT->deleteChildren();
-		  
-		  set<Trie>::iterator tmp = runner++;
+		  typename set<Trie>::iterator tmp = runner++;
 		  items->erase(tmp);
       }
     }
@@ -1471,7 +1358,8 @@ int Trie::pruneNodes(int level, set<Trie> *items, int depth)
 *  ( Demetrovics et Thi approach )
 */
 
-void Trie::trMinI( short unsigned * itemset, int level )
+template< class Item >
+void Trie< Item >::trMinI( Item * itemset, int level )
 {
 	Trie * bi ;
 
@@ -1508,7 +1396,8 @@ void Trie::trMinI( short unsigned * itemset, int level )
 	
 }
 
-void Trie::trMinI( vector< short unsigned > * itemset )
+template< class Item >
+void Trie< Item >::trMinI( vector< Item > * itemset )
 {
 	Trie * bi ;
 
@@ -1556,12 +1445,13 @@ void Trie::trMinI( vector< short unsigned > * itemset )
 *                             k the actual level of the
 *								levelwise approach  
 *  it also enable the separation of the minimal transversals
-*  that "generate" frequent already tested ("freqTr") from the 
-*  others, without affecting the process of the 
-*  minimals transversals
+*  that "generate" frequent already tested ("freqTr", given by 
+*  its index) from the others, without affecting the process of
+*  the minimals transversals
 */
 
-void Trie::trMinIopt( vector< short unsigned > * itemset, int n, int k, Trie * freqTr )
+template< class Item >
+void Trie< Item >::trMinIopt( vector< Item > * itemset, int n, int k, SubsetIndex< Item > * freqTr, int nbThreads )
 {
 
 	Trie * bi ;
@@ -1585,7 +1475,7 @@ void Trie::trMinIopt( vector< short unsigned > * itemset, int n, int k, Trie * f
 	// of itemset,
 	// this set of itemset is returned by the method
 
-	res = newItTr( bi, itemset,  freqTr ) ;
+	res = newItTr( bi, itemset, freqTr, nbThreads ) ;
 
 	delete bi;
 	
@@ -1615,50 +1505,61 @@ void Trie::trMinIopt( vector< short unsigned > * itemset, int n, int k, Trie * f
 *  minimals transversals
 */
 
-void Trie::trMinIopt( Trie * tr, int n, int k, Trie * freqTr  ) 
+template< class Item >
+void Trie< Item >::trMinIopt( Trie * tr, int n, int k, Trie * freqTr, int nbThreads ) 
 {
-	vector< short unsigned > * vect ;
+	TrieIterator< Item > it( tr ) ;
 
-	vect = new vector<short unsigned>() ;
+	SubsetIndex< Item > freqIndex( freqTr ) ;
 
-	if( tr->getChildren() != 0 )
-		trMinIopt( tr->getChildren() , vect, n, k, freqTr ) ;
-	
-	delete vect ;
+	// each itemset of tr is a new edge of the hypergraph
+
+	while( it.next() )
+		trMinIopt( it.getItemset(), n, k, &freqIndex, nbThreads ) ;
 }
 
-void Trie::trMinIopt( set< Trie > * items, vector< short unsigned > * vect, int n, int k, Trie * freqTr  ) 
-{
+// ----------------------------------------------------------------------------------------------
 
-	if( ( items != 0 ) && ( !items->empty() ) )
-	{
+/**
+*  functor adding an edge to the minimal transversals
+*/
 
-		for(set< Trie >::iterator runner = items->begin(); runner != items->end(); runner++ )
-		{
-			
-			// we save the curent item of the itemset being processed
+template< class Item >
+struct EdgeAdder
+{
+	Trie< Item > * transv ;
 
-			vect->push_back( runner->getId() ) ;					
+	int n ;
 
-			// we continue searching with the next items
+	int k ;
 
-			trMinIopt( runner->getChildren() , vect, n, k, freqTr ) ;
+	SubsetIndex< Item > * freqTr ;
 
-			vect->pop_back() ;
-				
-		}
+	int nbThreads ;
 
-	}
-	else	// we have check all the items of the current itemset strored in vect
-			// so we insert the new edge in the hypergraph
-	{
+	EdgeAdder( Trie< Item > * inTransv, int inN, int inK, SubsetIndex< Item > * inFreqTr, int inNbThreads ) 
+		: transv( inTransv ), n( inN ), k( inK ), freqTr( inFreqTr ), nbThreads( inNbThreads ) {}
 
+	void operator()( vector< Item > * edge, unsigned int )
+	{
+		transv->trMinIopt( edge, n, k, freqTr, nbThreads ) ;
+	}
+};
 
-			trMinIopt( vect, n, k, freqTr ) ;	
+/**
+*  method which calcul the minimal transversal with the edges
+*  stored in the compact trie in parameter
+*  ( see the previous method )
+*/
 
+template< class Item >
+void Trie< Item >::trMinIopt( CompactTrie< Item > * tr, int n, int k, Trie * freqTr, int nbThreads ) 
+{
+	SubsetIndex< Item > freqIndex( freqTr ) ;
 
-	}
+	EdgeAdder< Item > adder( this, n, k, &freqIndex, nbThreads ) ;
 
+	tr->visitItemsets( adder ) ;
 }
 
 // ----------------------------------------------------------------------------------------------
@@ -1668,20 +1569,14 @@ void Trie::trMinIopt( set< Trie > * items, vector< short unsigned > * vect, int
 *  itemset
 */
 
-Trie * Trie::trMin()
+template< class Item >
+Trie< Item > * Trie< Item >::trMin()
 {
 	Trie * res ;
 
-	vector< short unsigned > * vect ;
-
 	res = new Trie( 0 ) ;
 	
-	vect = new vector< short unsigned >() ;
-
-	if( children != 0 )
-		trMin( children, vect, res ) ;
-
-	delete vect ;
+	res->trMinI( this ) ;
 
 	return res ;
 
@@ -1695,68 +1590,44 @@ Trie * Trie::trMin()
 *  from the minimal transversal with i edges ( this set ) 
 *  and a new edge ( Demetrovics et Thi approach )
 */
-void Trie::trMinI( Trie * tr )
+template< class Item >
+void Trie< Item >::trMinI( Trie * tr )
 {
-	vector< short unsigned > * vect ;
-
-	vect = new vector<short unsigned>() ;
-
-	if( tr->getChildren() != 0 )
-		trMin( tr->getChildren() , vect, this ) ;
-	
-	delete vect ;
-}
+	TrieIterator< Item > it( tr ) ;
 
+	vector< Item > * vect ;
 
-void Trie::trMin( set< Trie > * items, vector< short unsigned > * vect, Trie * res ) 
-{
-	set< Trie > * tmp ;
+	// each itemset of tr is a new edge for the hypergraph of trMin( i+1 )
 
-	if( ( items != 0 ) && ( !items->empty() ) )
+	while( it.next() )
 	{
+		vect = it.getItemset() ;
 
-		for(set< Trie >::iterator runner = items->begin(); runner != items->end(); runner++ )
-		{
-			
-			// we save the curent item of the itemset being processed
-
-			vect->push_back( runner->getId() ) ;
-
-			// we continue searching with the next items
-
-			trMin( runner->getChildren(), vect, res ) ;
-
-			vect->pop_back() ;
-				
-		}
-
+		if ( children == 0 )
+			initTr( vect ) ;
+		else
+			trMinI( vect ) ;
 	}
-	else	// we have saved all the items of the current itemset in vect
-			// so we have a new edge for the hypergraph of trMin( i+1 )
-	{
-
-		if ( res->getChildren() == 0 )
-		{
-			// for the first edge of the iteration
-			// we simply add all the items
+}
 
-			tmp = res->makeChildren() ;
+// ----------------------------------------------------------------------------------------------
 
-			for( int i= 0; i < vect->size(); i++ )
-			{
-				res->support ++ ;
-				
-				tmp->insert( Trie( (*vect)[ i ] ) ) ;
-			}
-		}
-		else
-		{
-			res->trMinI( vect ) ;
-		}
+/**
+*  method that initialise the minimal transversals with the
+*  first edge of the hypergraph, ie all the items of the edge
+*/
 
+template< class Item >
+void Trie< Item >::initTr( vector< Item > * vect )
+{
+	set< Trie > * tmp = makeChildren() ;
 
+	for( int i= 0; i < vect->size(); i++ )
+	{
+		support ++ ;
+		
+		tmp->insert( Trie( (*vect)[ i ] ) ) ;
 	}
-
 }
 
 // ----------------------------------------------------------------------------------------------
@@ -1771,74 +1642,31 @@ void Trie::trMin( set< Trie > * items, vector< short unsigned > * vect, Trie * r
 *								levelwise approach  
 */
 
-Trie * Trie::trMinOpt( int n, int k )
+template< class Item >
+Trie< Item > * Trie< Item >::trMinOpt( int n, int k )
 {
 	Trie * res ;
 
-	vector< short unsigned > * vect ;
-
-	res = new Trie( 0 ) ;
-	
-	vect = new vector< short unsigned >() ;
+	TrieIterator< Item > it( this ) ;
 
-	if( children != 0 )
-		trMinOpt( children, vect, res, n, k ) ;
+	vector< Item > * vect ;
 
-	delete vect ;
-
-	return res ;
-
-}
-
-void Trie::trMinOpt( set< Trie > * items, vector< short unsigned > * vect, Trie * res, int n, int k ) 
-{
-	set< Trie > * tmp ;
-
-	if( ( items != 0 ) && ( !items->empty() ) )
-	{
-
-		for(set< Trie >::iterator runner = items->begin(); runner != items->end(); runner++ )
-		{
-			
-			// we save the curent item of the itemset being processed
-
-			vect->push_back( runner->getId() ) ;
-
-			// we continue searching with the next items
-
-			trMinOpt( runner->getChildren(), vect, res,n,k ) ;
+	res = new Trie( 0 ) ;
 
-			vect->pop_back() ;
-				
-		}
+	// each itemset is a new edge for the hypergraph of trMin( i+1 )
 
-	}
-	else	// we have saved all the items of the current itemset in vect
-			// so we have a new edge for the hypergraph of trMin( i+1 )
+	while( it.next() )
 	{
+		vect = it.getItemset() ;
 
 		if ( res->getChildren() == 0 )
-		{
-			// for the first edge of the iteration
-			// we simply add all the items
-
-			tmp = res->makeChildren() ;
-
-			for( int i= 0; i < vect->size(); i++ )
-			{
-				res->support ++ ;
-				
-				tmp->insert( Trie( (*vect)[ i ] ) ) ; 
-			}
-		}
+			res->initTr( vect ) ;
 		else
-		{
 			res->trMinIopt( vect,n,k,0 ) ;
-		}
-
-
 	}
 
+	return res ;
+
 }
 
 // ----------------------------------------------------------------------------------------------
@@ -1851,28 +1679,43 @@ void Trie::trMinOpt( set< Trie > * items, vector< short unsigned > * vect, Trie
 *  complementary 
 */
 
-Trie *  Trie::complem( int nb   ) 
+template< class Item >
+Trie< Item > *  Trie< Item >::complem( int nb   ) 
 {
 
 	Trie * res ;
 
 	res = new Trie( 0 ) ;
 
-	vector< short unsigned > * vect ;
+	vector< Item > * comp ;
 	
 	set< Trie > * items;
 
-	set< Trie >::iterator runner ;
+	typename set< Trie >::iterator runner ;
 
 	int i ;
 
 	if( res != 0 )
 	{	
 	
-		vect = new vector< short unsigned >() ;
-
 		if( children != 0 )
-			complRec( nb, children, vect, res ) ;
+		{
+			// the buffer of the complement is reused for all the itemsets
+
+			TrieIterator< Item > it( this ) ;
+
+			comp = new vector< Item >() ;
+
+			while( it.next() )
+			{
+				complem( it.getItemset(), nb, comp ) ;
+
+				if( comp->empty() == false )
+					res->insert( comp ) ;
+			}
+
+			delete comp ;
+		}
 		else
 		{
 			i = 1 ;
@@ -1898,69 +1741,44 @@ Trie *  Trie::complem( int nb   )
 
 		}
 
-		delete vect ;
 	}
 
 	return res ;
 
 }
 
-void Trie::complRec( int nb, set< Trie > * items, vector< short unsigned > * vect, Trie * res ) 
-{
-
-	vector< short unsigned > * comp ;
-
-	if( ( items != 0 ) && ( !items->empty() ) )
-	{
-
-		for(set< Trie >::iterator runner = items->begin(); runner != items->end(); runner++ )
-		{
-			
-			// we save the curent item of the itemset being processed
-
-			vect->push_back( runner->getId() ) ;
-
-			// we continue searching with the next items
-
-			complRec( nb, runner->getChildren(), vect, res ) ;
-
-			vect->pop_back() ;
-				
-		}
+// ----------------------------------------------------------------------------------------------
 
-	}
-	else	// we have saved all the items of the current itemset in vect
-			// so we complement it 
-	{
-		
-		comp = complem( vect, nb ) ;
+/*
+*  method that proces the complement of 
+*  an itemset in whom the items are
+*  between 1 and nb
+*/
 
-		if( comp->empty() == false )
-			res->insert( comp ) ;
+template< class Item >
+vector< Item > * Trie< Item >::complem( vector< Item > * vect, int nb ) 
+{
 
-		delete comp ;
+	vector< Item > * comp ;
 
-	
+	comp = new vector< Item >() ;
 
-	}
+	complem( vect, nb, comp ) ;
 
+	return comp ;
 
 }
 
-// ----------------------------------------------------------------------------------------------
-
 /*
-*  method that proces the complement of 
-*  an itemset in whom the items are
-*  between 1 and nb
+*  method that proces the complement of an itemset
+*  into the buffer comp ( the previous content is erased )
 */
 
-vector< short unsigned > * Trie::complem( vector< short unsigned > * vect, int nb ) 
+template< class Item >
+void Trie< Item >::complem( vector< Item > * vect, int nb, vector< Item > * comp ) 
 {
 
-	vector< short unsigned > * comp ;
-
-	comp = new vector< short unsigned >() ;
+	comp->clear() ;
 
 	// we complement the items who are before the first item of
 	// the current itemset
@@ -1984,9 +1802,6 @@ vector< short unsigned > * Trie::complem( vector< short unsigned > * vect, int n
 	for( int l =  (*vect)[ vect->size()-1 ] + 1 ; l < nb ; l++ ) 
 			comp->push_back(l  ) ;	
 
-
-	return comp ;
-
 }
 
 // ---------------------------------------------------------------------------------------------- 
@@ -1996,7 +1811,8 @@ vector< short unsigned > * Trie::complem( vector< short unsigned > * vect, int n
 *  and return the number of subsets deleted
 */
 
-int Trie::delSubsets( short unsigned *iset, int level, set<Trie> *items, int spos, int depth)
+template< class Item >
+int Trie< Item >::delSubsets( Item *iset, int level, set<Trie> *items, int spos, int depth)
 {
   
 	int del = 0 ;
@@ -2004,7 +1820,7 @@ int Trie::delSubsets( short unsigned *iset, int level, set<Trie> *items, int spo
 	if( items !=0 )
 	{
 
-		set<Trie>::iterator runner;
+		typename set<Trie>::iterator runner;
   
 		int loper = spos;
 		spos = depth+1;
@@ -2030,9 +1846,6 @@ int Trie::delSubsets( short unsigned *iset, int level, set<Trie> *items, int spo
 
 				if( ( runner->getChildren() ) == 0 || ( runner->getChildren()->empty() ) )
 				{
-					Trie * tmpT = const_cast< Trie * >( &(*runner) ) ;
-					tmpT->deleteChildren() ;
-
 					items->erase( runner ) ;
 
 					if( depth == level -1 )
@@ -2057,14 +1870,15 @@ int Trie::delSubsets( short unsigned *iset, int level, set<Trie> *items, int spo
 *  without knowing the level of iset
 */
 	
-int Trie::delSubsets( vector< short unsigned > * iset, set<Trie> *items, int spos , int depth ) 
+template< class Item >
+int Trie< Item >::delSubsets( vector< Item > * iset, set<Trie> *items, int spos , int depth ) 
 {
 	int del = 0 ;
 
 	if( items !=0 )
 	{
 
-		set<Trie>::iterator runner;
+		typename set<Trie>::iterator runner;
   
 		int loper = spos;
 		spos = depth+1;
@@ -2090,9 +1904,6 @@ int Trie::delSubsets( vector< short unsigned > * iset, set<Trie> *items, int spo
 
 				if( ( runner->getChildren() ) == 0 || ( runner->getChildren()->empty() ) )
 				{
-					Trie * tmpT = const_cast< Trie * >( &(*runner) ) ;
-					tmpT->deleteChildren() ;
-
 					items->erase( runner ) ;
 
 					if( depth == iset->size() -1  )
@@ -2112,10 +1923,11 @@ int Trie::delSubsets( vector< short unsigned > * iset, set<Trie> *items, int spo
 *  the subsets of size "size" of an itemsets of size k
 */
 
-void Trie::genSubsets(  vector< short unsigned > * itemset, set<Trie> *items, int spos , int depth ) 
+template< class Item >
+void Trie< Item >::genSubsets(  vector< Item > * itemset, set<Trie> *items, int spos , int depth ) 
 {
 
-	set<Trie>::iterator runner;
+	typename set<Trie>::iterator runner;
   
 	int loper = spos;
 	spos = depth+1;
@@ -2165,54 +1977,96 @@ void Trie::genSubsets(  vector< short unsigned > * itemset, set<Trie> *items, in
 *  "size" of this set of itemsets 
 */
 
-Trie * Trie::genSubsets( int size ) 
+template< class Item >
+Trie< Item > * Trie< Item >::genSubsets( int size ) 
 {
 	Trie * subset ;
-	
-	vector< short unsigned > * itemset = new vector<short unsigned>() ;
 
-	if( children != 0 )
-	{
-		subset = new Trie( 0 ) ;
+	TrieIterator< Item > it( this ) ;
 
-		genSubsets( size, itemset, children, subset ) ;	
-	}		
-	
-	delete itemset ;
+	subset = new Trie( 0 ) ;
+
+	// we generate the subsets of each itemset
+
+	while( it.next() )
+		subset->genSubsets( it.getItemset(), size ) ;		
 
 	return subset ;
 
 }
 
-void Trie::genSubsets( int size, vector< short unsigned > * itemset, set< Trie > * items, Trie * subset ) 
+// ---------------------------------------------------------------------------------------------- 
+
+/**
+*  method that insert into this node ( at depth "depth" of
+*  the trie root ) the subsets of the itemsets of the sub
+*  tree of node with one item less : the item of node is
+*  removed from all of them, they are the itemsets of its
+*  children, or it is kept and one of the next items is
+*  removed, recursively. So each subset is inserted once
+*  by node whose item is removed and not once by itemset,
+*  the number of subsets inserted is added to the support
+*  of root
+*/
+
+template< class Item >
+void Trie< Item >::addSubsets( Trie * node, int depth, int size, Trie * root ) 
 {
-	
-	if( ( items != 0 ) && ( !items->empty() ) )
-	{
+	pair< typename set<Trie>::iterator, bool > runner ;
 
-		for(set< Trie >::iterator runner = items->begin(); runner != items->end(); runner++ )
-		{
-			
-			// we save the curent item of the itemset being processed
+	if( ( node->children == 0 ) || node->children->empty() )
+		return ;	// the itemset without the item of node is this node
 
-			itemset->push_back( runner->getId() ) ;
-			
-			// we continue searching with the next items
+	// the item of node is removed
 
-			genSubsets( size, itemset, runner->getChildren(), subset ) ;
+	addItemsets( node->children, depth, size, root ) ;
 
-			itemset->pop_back() ;
-				
-		}
+	// the item of node is kept
 
-	}
-	else	// we have check all the items of the current itemset strored in vect
-			// so we generate his subset
+	runner = children->insert( Trie( node->id, 0 ) ) ;
+
+	if( runner.second && ( depth + 1 == size ) )
+		root->support++ ;
+
+	if( depth + 1 < size )
 	{
+		Trie * tmpT = const_cast< Trie * >( &(*runner.first ) ) ;
 
-		subset->genSubsets( itemset, size ) ;		
+		tmpT->makeChildren() ;
 
+		for( typename set<Trie>::iterator itChild = node->children->begin(); itChild != node->children->end() ; itChild++ )
+			tmpT->addSubsets( const_cast< Trie * >( &(*itChild ) ), depth + 1, size, root ) ;
 	}
+}
+
+/**
+*  method that insert into this node ( at depth "depth" of
+*  the trie root ) the itemsets of items
+*/
 
+template< class Item >
+void Trie< Item >::addItemsets( set< Trie > * items, int depth, int size, Trie * root ) 
+{
+	pair< typename set<Trie>::iterator, bool > runner ;
+
+	makeChildren() ;
+
+	for( typename set<Trie>::iterator itItem = items->begin(); itItem != items->end() ; itItem++ )
+	{
+		runner = children->insert( Trie( itItem->id, 0 ) ) ;
+
+		if( runner.second && ( depth + 1 == size ) )
+			root->support++ ;
+
+		if( ( itItem->children != 0 ) && ! itItem->children->empty() )
+			const_cast< Trie * >( &(*runner.first ) )->addItemsets( itItem->children, depth + 1, size, root ) ;
+	}
 }
 
+// ----------------------------------------------------------------------------------------------
+
+// instantiation for the item identifiers on 8, 16 and 32 bits
+
+template class Trie< unsigned char > ;
+template class Trie< short unsigned > ;
+template class Trie< unsigned int > ;
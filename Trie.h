@@ -17,8 +17,21 @@
 #include <iostream>
 #include <fstream>
 
+#include "OutputSink.h"
+
 using namespace std;
 
+template< class Item > class CompactTrie ;
+
+template< class Item > class SubsetIndex ;
+
+// ----------------------------------------------------------
+// Item is the type of the internal identifiers of the items
+// ( unsigned char, short unsigned or unsigned int wrt the
+//   number of frequent items )
+// ----------------------------------------------------------
+
+template< class Item >
 class Trie
 {
 protected:
@@ -27,7 +40,7 @@ protected:
     // identifier of the item in the node
     // -----------------------------------
 
-	short unsigned id;
+	Item id;
 	
 	// --------------------------------
 	// support of the current itemset
@@ -47,10 +60,18 @@ protected:
 
 public:
 
-	Trie(short unsigned i=-1) : id(i), support(0), children(0) {}
-	Trie(short unsigned i, unsigned int supp) : id(i), support(supp), children(0) {}
-	Trie(const Trie &i) : id(i.id), support(i.support), children(i.children) {}
-	~Trie(){}
+	Trie(Item i=-1) : id(i), support(0), children(0) {}
+	Trie(Item i, unsigned int supp) : id(i), support(supp), children(0) {}
+
+	// ------------------------------------------------
+	// a node owns its sub tree: the copy duplicates
+	// the sub tree and the move transfers it
+	// ------------------------------------------------
+
+	Trie(const Trie &i) : id(i.id), support(i.support), 
+		children( i.children ? new set<Trie>( *i.children ) : 0 ) {}
+	Trie(Trie &&i) noexcept : id(i.id), support(i.support), children(i.children) { i.children = 0 ; }
+	~Trie(){ delete children ; }
 
 	// ---------------------
 	// affectation operator
@@ -58,11 +79,13 @@ public:
 
 	Trie & operator = ( const Trie & inTrie ) ;
 
+	Trie & operator = ( Trie && inTrie ) noexcept ;
+
 	// --------------------------------
 	// method returning the attributes
 	// --------------------------------
 	
-	short unsigned getId() const {return id;}
+	Item getId() const {return id;}
 	
 	unsigned int getSupport() const {return support;}
 
@@ -94,6 +117,13 @@ public:
 
 	int deleteChildren();
 
+	// ---------------------------------------------------
+	// method returning the number of nodes of the sub
+	// tree of this node ( this node is not counted )
+	// ---------------------------------------------------
+
+	unsigned long countNodes() const ;
+
 	// ------------------------------------------------------------------
 	// Operator < to have a prefix ordered wrt their internal identifier
 	// ie increasing support 
@@ -105,13 +135,21 @@ public:
 	// method that initialize the id 
 	// ------------------------------
 
-	void setId( short unsigned inId ) { id = inId ; }  
+	void setId( Item inId ) { id = inId ; }  
 
-	// --------------------------------
+	// -------------------------------------------------
 	// method that initialize children 
-	// --------------------------------
+	// NOTE : this node takes the ownership of inChild,
+	//        the previous sub tree is deleted
+	// -------------------------------------------------
 
-	void setChildren( set<Trie> * inChild ) { children = inChild ; }  
+	void setChildren( set<Trie> * inChild ) { if( children != inChild ) delete children ; children = inChild ; }  
+
+	// -------------------------------------------------
+	// method that give up the ownership of the sub tree
+	// -------------------------------------------------
+
+	set<Trie> *releaseChildren() { set<Trie> * res = children ; children = 0 ; return res ; }
 
 	// -----------------------------------
 	// method that initialize the support 
@@ -124,33 +162,40 @@ public:
 	// items is included into itemset
 	// -----------------------------------
 
-	bool includedIn( short unsigned * itemset, int level ) ;
+	bool includedIn( Item * itemset, int level ) ;
 
-	bool includedIn( set<Trie> * items, short unsigned * itemset, int level, int spos = 0 ) ;
+	bool includedIn( set<Trie> * items, Item * itemset, int level, int spos = 0 ) ;
 
 	
-	bool includedIn( vector< short unsigned > * itemset ) ;
+	bool includedIn( vector< Item > * itemset ) ;
+
+	bool includedIn( set<Trie> * items, vector< Item > * itemset, int spos = 0 ) ;
+
 
-	bool includedIn( set<Trie> * items, vector< short unsigned > * itemset, int spos = 0 ) ;
+	bool includedIn( list< Item > * itemset ) ;
 
+	bool includedIn( set<Trie> * items, list< Item > * itemset, typename list< Item >::iterator spos ) ;
 
-	bool includedIn( list< short unsigned > * itemset ) ;
+	// -------------------------------------------------
+	// method searching if one itemset of items including
+	// the item itemset[ mpos ] is included into itemset
+	// -------------------------------------------------
 
-	bool includedIn( set<Trie> * items, list< short unsigned > * itemset, list< short unsigned >::iterator spos ) ;
+	bool includedInWith( set<Trie> * items, vector< Item > * itemset, int mpos, int spos = 0 ) ;
 
 	// ----------------------------------------------
 	// method searching if itemset is include in one
 	// of the itemsets of this set of itemset
 	// ----------------------------------------------
 	
-	bool include( vector< short unsigned > * itemset ){ return include( children, itemset, 0 ) ; } ;
+	bool include( vector< Item > * itemset ){ return include( children, itemset, 0 ) ; } ;
 
-	bool include( set<Trie> * items, vector< short unsigned > * itemset, int spos = 0 ) ;
+	bool include( set<Trie> * items, vector< Item > * itemset, int spos = 0 ) ;
 
 
-	bool include( short unsigned * itemset, int size ){ return include( children, itemset, size, 0 ) ; } ;
+	bool include( Item * itemset, int size ){ return include( children, itemset, size, 0 ) ; } ;
 
-	bool include( set<Trie> * items, short unsigned * itemset, int size, int spos = 0 ) ;
+	bool include( set<Trie> * items, Item * itemset, int size, int spos = 0 ) ;
 
 	// ---------------------------------------------------
 	// print to screen all the itemset stored in tree
@@ -158,20 +203,16 @@ public:
 	// if remap is 0 it use the internal id
 	// ---------------------------------------------------
 
-	void printItemsets( short unsigned * remap = 0 ) ;
-
-	void printItemsets( short unsigned * remap, set< Trie > * items, vector< short unsigned > * vect, int inSup = 0 ) ;
+	void printItemsets( int * remap = 0 ) ;
 
 	// ---------------------------------------------------
 	// save into a file all the itemset stored in tree
 	// remap is a table for mapping the name of the items
 	// if remap is 0 it use the internal id
+	// mode is the way the file is written ( OutputSink )
 	// ---------------------------------------------------
 
-	void saveItemsets( const char * fileName, short unsigned * remap = 0 ) ;
-
-	void saveItemsets( ofstream & pFile, short unsigned * remap , set< Trie > * items, vector< short unsigned > * vect
-		, int inSup = 0) ;
+	void saveItemsets( const char * fileName, int * remap = 0, SinkMode mode = SINK_WRITE ) ;
 
 	// ---------------------------------------------------
 	// save into a file all the itemset stored in tree
@@ -179,9 +220,7 @@ public:
 	// according the FIMI format of datasets 
 	// ---------------------------------------------------
 
-	void saveDataSet( const char * fileName, short unsigned * remap ) ;
-
-	void saveDataSet( ofstream & pFile, short unsigned * remap, set< Trie > * items, list< unsigned >  * lst ) ;
+	void saveDataSet( const char * fileName, int * remap ) ;
 
 	// ----------------------------------------------------------------
 	// method which construct 
@@ -193,15 +232,16 @@ public:
 	//       of Ei+1, bi is Bi  
 	// ----------------------------------------------------------------
 
-	void initTrBi( short unsigned * itemset, int level,  Trie * bi ) ;
+	void initTrBi( Item * itemset, int level,  Trie * bi ) ;
 
-	void initTrBi( vector< short unsigned > * itemset,  Trie * bi ) ;
+	void initTrBi( vector< Item > * itemset,  Trie * bi ) ;
 
-	bool initTrBi( set< Trie > * items, short unsigned * itemset, int level,Trie * bi,
-		vector< short unsigned > * vect) ;
+	// --------------------------------------------------------
+	// method that test if the itemset vect and the itemset
+	// "itemset" of size "level" have a common item
+	// --------------------------------------------------------
 
-	bool initTrBi( set< Trie > * items, vector< short unsigned > * itemset,Trie * bi,
-			vector< short unsigned > * vect) ;
+	static bool intersects( vector< Item > * vect, Item * itemset, int level ) ;
 
 	// ----------------------------------------------------------------
 	// method which construct 
@@ -217,10 +257,7 @@ public:
 	//                        k the level of the levelwise approach  
 	// ----------------------------------------------------------------
 
-	void initTrBiOpt( vector< short unsigned > * itemset,  Trie * bi, int n, int k ) ;
-
-	bool initTrBiOpt( set< Trie > * items, vector< short unsigned > * itemset,Trie * bi,
-		vector< short unsigned > * vect, bool intersect, int n, int k ) ;
+	void initTrBiOpt( vector< Item > * itemset,  Trie * bi, int n, int k ) ;
 
 	// ------------------------------------------------------
 	// method which insert an itemset in this set of itemset
@@ -231,11 +268,11 @@ public:
 	//        the trie
 	// ------------------------------------------------------
 
-	void insert( short unsigned * itemset, int level, int inSup = 0 ) ;
+	void insert( Item * itemset, int level, int inSup = 0 ) ;
 
-	void insert( vector< short unsigned > * itemset, int inSup = 0 ) ;
+	void insert( vector< Item > * itemset, int inSup = 0 ) ;
 
-	void insert( list< short unsigned > * itemset, int inSup = 0 ) ;
+	void insert( list< Item > * itemset, int inSup = 0 ) ;
 
 	// ------------------------------------------------------
 	// method which delete an itemset in this set of itemset
@@ -246,19 +283,9 @@ public:
 	//        the trie
 	// ------------------------------------------------------
 
-	void deleteIt( vector< short unsigned > * itemset ) ;
+	void deleteIt( vector< Item > * itemset ) ;
 
-	int deleteIt( vector< short unsigned > * itemset, set< Trie > * items, int pos=0 ) ;
-	
-	// ----------------------------------------------------
-	// method generating the new itemsets for Tr(i+1) with 
-	// Tr(i), Bi, the new edge itemset
-	// ----------------------------------------------------
-
-	Trie * newItTr( Trie * bi, short unsigned * itemset, int level ) ;
-
-	void newItTr( set< Trie > * trs, set< Trie > * bis, short unsigned * itemset, int level,
-						  list< short unsigned > * lst, Trie * res ) ;
+	int deleteIt( vector< Item > * itemset, set< Trie > * items, int pos=0 ) ;
 	
 	// ----------------------------------------------------
 	// method generating the new itemsets for Tr(i+1) with 
@@ -268,23 +295,34 @@ public:
 	// that "generate" frequent already tested from the 
 	// others, without affecting the process of the 
 	// minimals transversals
+	// the generation is shared between nbThreads threads
+	// by sub tree of Bi when Bi is large enough
+	// the transversals that "generate" frequent are
+	// given by an index ( see SubsetIndex )
 	// ----------------------------------------------------
 
-	Trie * newItTr( Trie * bi, vector< short unsigned > * itemset, Trie * freqTr = 0 ) ;
+	Trie * newItTr( Trie * bi, Item * itemset, int level, SubsetIndex< Item > * freqTr = 0, int nbThreads = 1 ) ;
 
-	void newItTr( set< Trie > * trs, set< Trie > * bis, vector< short unsigned > * itemset,
-						  list< short unsigned > * lst, Trie * res, set< Trie > * freqTrChild = 0 ) ;
+	Trie * newItTr( Trie * bi, vector< Item > * itemset, SubsetIndex< Item > * freqTr = 0, int nbThreads = 1 ) ;
+
+	// -----------------------------------------------------
+	// method generating into res the new itemsets for
+	// Tr(i+1) with the itemsets of bi, bi is consumed
+	// -----------------------------------------------------
+
+	void genItTr( Trie * bi, Item * itemset, int level, SubsetIndex< Item > * freqTr, Trie * res ) ;
 
 
 	// -------------------------------------------------
 	// method merging this sets of itemset 
 	// and trie2 into this set 
-	// note: the set trie2 is destructed after the copy
+	// note: the nodes of trie2 are moved into this set,
+	//       trie2 is empty after the merge
 	// -------------------------------------------------
 
 	void merge( Trie * trie2 ) ;
 
-	void merge( set< Trie > * trieC1, set< Trie > * trieC2 ) ;
+	void mergeChildren( Trie * trie2 ) ;
 
 	// -----------------------------------
 	// method that delete all the itemset
@@ -301,9 +339,9 @@ public:
 	// and a new edge ( Demetrovics et Thi approach )
 	// -----------------------------------------------------------
 
-	void trMinI( short unsigned * itemset, int level );
+	void trMinI( Item * itemset, int level );
 
-	void trMinI( vector< short unsigned > * itemset );
+	void trMinI( vector< Item > * itemset );
 
 	// -------------------------------------------------------------
 	// method which calcul the minimal transversal with i+1 edges
@@ -318,9 +356,12 @@ public:
 	// that "generate" frequent already tested from the 
 	// others, without affecting the process of the 
 	// minimals transversals
+	// nbThreads threads are used to generate the new transversals
+	// the transversals that "generate" frequent are given by an
+	// index of freqTr ( built once for all the edges )
 	// -------------------------------------------------------------
 
-	void trMinIopt( vector< short unsigned > * itemset, int n, int k, Trie * freqTr=0  );
+	void trMinIopt( vector< Item > * itemset, int n, int k, SubsetIndex< Item > * freqTr=0, int nbThreads=1 );
 
 	// -------------------------------------------------------------
 	// method which calcul the minimal transversal with the edges
@@ -338,9 +379,13 @@ public:
 	// minimals transversals
 	// -------------------------------------------------------------
 
-	void trMinIopt( Trie * tr, int n, int k, Trie * freqTr=0  ) ;
+	void trMinIopt( Trie * tr, int n, int k, Trie * freqTr=0, int nbThreads=1 ) ;
+
+	// -------------------------------------------------------------
+	// same method with the edges stored in a compact trie
+	// -------------------------------------------------------------
 
-	void trMinIopt( set< Trie > * items, vector< short unsigned > * vect, int n, int k, Trie * freqTr  ) ;
+	void trMinIopt( CompactTrie< Item > * tr, int n, int k, Trie * freqTr=0, int nbThreads=1 ) ;
 
 	// -----------------------------------------------------------
 	// method which calcul the minimal transversal of this set of
@@ -358,7 +403,12 @@ public:
 	
 	void trMinI( Trie * tr ) ;
 
-	void trMin( set< Trie > * items, vector< short unsigned > * vect, Trie * res ) ;
+	// ------------------------------------------------------
+	// method that initialise the minimal transversals with
+	// the first edge of the hypergraph
+	// ------------------------------------------------------
+
+	void initTr( vector< Item > * vect ) ;
 
 	// -----------------------------------------------------------
 	// method which calcul the minimal transversal of this set of
@@ -376,8 +426,6 @@ public:
 
 	Trie * trMinOpt( int n, int k );
 
-	void trMinOpt( set< Trie > * items, vector< short unsigned > * vect, Trie * res, int n, int k ) ;
-
 
 	// -----------------------------------------------------------------
 	// method that construct the complementary of this set of itemset
@@ -389,15 +437,15 @@ public:
 
 	Trie * complem( int nb ) ;
 
-	void complRec( int nb, set< Trie > * items, vector< short unsigned > * vect, Trie * res ) ; 
-
 	// -------------------------------------
 	// method that proces the complement of 
 	// an itemset in whom the items are
 	// between 1 an nb
 	// -------------------------------------
 
-	vector< short unsigned > * complem( vector< short unsigned > * vect, int nb ) ;
+	vector< Item > * complem( vector< Item > * vect, int nb ) ;
+
+	void complem( vector< Item > * vect, int nb, vector< Item > * comp ) ;
 	
 	// -----------------------------------
 	// method that delete all the subsets
@@ -405,7 +453,7 @@ public:
 	// the number of subsets deleted
 	// -----------------------------------
 
-	int delSubsets( short unsigned *iset, int level, int size) 
+	int delSubsets( Item *iset, int level, int size) 
 		{ return delSubsets( iset, level, children, 0, level - size ) ;  }
 
 	// -------------------------------------
@@ -414,7 +462,7 @@ public:
 	// return the number of subsets deleted
 	// -------------------------------------
 
-	int delSubsets( short unsigned *iset, int level, set<Trie> *items, int spos = 0, int depth = 1) ;
+	int delSubsets( Item *iset, int level, set<Trie> *items, int spos = 0, int depth = 1) ;
 	
 	// -----------------------------------
 	// method that delete all the subsets
@@ -423,7 +471,7 @@ public:
 	// without knowing the level of iset
 	// -----------------------------------
 
-	int delSubsets( vector< short unsigned > * iset, int size) 
+	int delSubsets( vector< Item > * iset, int size) 
 		{ return delSubsets( iset, children, 0, iset->size() - size ) ;  }
 
 	// -------------------------------------
@@ -433,7 +481,7 @@ public:
 	// without knowing the level of iset
 	// -------------------------------------
 
-	int delSubsets( vector< short unsigned > * iset, set<Trie> *items, int spos = 0, int depth = 1); 
+	int delSubsets( vector< Item > * iset, set<Trie> *items, int spos = 0, int depth = 1); 
 
 	// ------------------------------------------
 	// method that generate into this set 
@@ -441,10 +489,10 @@ public:
 	// Note: items must be already alocated
 	// -------------------------------------------
 
-	void genSubsets(  vector< short unsigned > * itemset, int size )
+	void genSubsets(  vector< Item > * itemset, int size )
 	{ genSubsets( itemset, makeChildren(), 0, itemset->size() - size ); }
 
-	void genSubsets(  vector< short unsigned > * itemset, set<Trie> *items, int spos = 0, int depth = 1) ;
+	void genSubsets(  vector< Item > * itemset, set<Trie> *items, int spos = 0, int depth = 1) ;
 
 	// ------------------------------------------------
 	// method that return a set of the subsets of size
@@ -453,7 +501,20 @@ public:
 
 	Trie * genSubsets( int size ) ;
 
-	void genSubsets( int size, vector< short unsigned > * itemset, set< Trie > * items, Trie * subset ) ;
+	// ------------------------------------------------
+	// method that generate into this set the subsets
+	// of size "size" ( one item less ) of the itemsets
+	// of node, a child of the root of its trie : they
+	// are generated from the nodes so a subset shared
+	// by several itemsets is inserted once by node
+	// and not once by itemset ( see addSubsets )
+	// ------------------------------------------------
+
+	void genImmediateSubsets( Trie * node, int size ) { addSubsets( node, 0, size, this ) ; }
+
+	void addSubsets( Trie * node, int depth, int size, Trie * root ) ;
+
+	void addItemsets( set< Trie > * items, int depth, int size, Trie * root ) ;
 
 };
 
@@ -0,0 +1,171 @@
+/*----------------------------------------------------------------------
+  File    : TrieIterator.cpp
+  Contents: Class that go through the itemsets stored in a prefix trie
+            in depth first order with an explicit stack (no recursion).
+            The items of the current itemset are stored in a buffer
+            reused for all the itemsets of the trie
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "TrieIterator.h"
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  constructor
+*/
+
+template< class Item >
+TrieIterator< Item >::TrieIterator( Trie< Item > * inRoot, int inMaxDepth )
+{
+	reset( inRoot, inMaxDepth ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that restart the iterator on a new trie
+*  the buffers are kept so that an iterator can be
+*  reused without new allocations
+*/
+
+template< class Item >
+void TrieIterator< Item >::reset( Trie< Item > * inRoot, int inMaxDepth )
+{
+	root = inRoot ;
+
+	maxDepth = inMaxDepth ;
+
+	sets.clear() ;
+	runners.clear() ;
+	itemset.clear() ;
+
+	erased = false ;
+	started = false ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that add a set of child nodes on the stack
+*/
+
+template< class Item >
+void TrieIterator< Item >::push( set< Trie< Item > > * items )
+{
+	sets.push_back( items ) ;
+
+	runners.push_back( items->begin() ) ;
+
+	itemset.push_back( items->begin()->getId() ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that go down from the current node
+*  to the first leaf of its sub tree
+*/
+
+template< class Item >
+void TrieIterator< Item >::descend()
+{
+	set< Trie< Item > > * items = runners.back()->getChildren() ;
+
+	while( ( items != 0 ) && ( ! items->empty() )
+		   && ( ( maxDepth < 0 ) || ( (int)itemset.size() < maxDepth ) ) )
+	{
+		push( items ) ;
+
+		items = runners.back()->getChildren() ;
+	}
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that move to the next itemset (leaf)
+*  return false when all the itemsets have been processed
+*/
+
+template< class Item >
+bool TrieIterator< Item >::next()
+{
+	bool empty ;
+
+	if( ! started )
+	{
+		started = true ;
+
+		if( ( root == 0 ) || ( root->getChildren() == 0 ) || ( root->getChildren()->empty() )
+			|| ( maxDepth == 0 ) )
+			return false ;
+
+		push( root->getChildren() ) ;
+
+		descend() ;
+
+		return true ;
+	}
+
+	if( sets.empty() )
+		return false ;
+
+	if( erased )
+		erased = false ;
+	else
+		runners.back()++ ;
+
+	// we go up while all the nodes of the current set have been processed
+
+	while( runners.back() == sets.back()->end() )
+	{
+		empty = sets.back()->empty() ;
+
+		sets.pop_back() ;
+		runners.pop_back() ;
+		itemset.pop_back() ;
+
+		if( sets.empty() )
+			return false ;
+
+		if( empty ) // all the children have been deleted so we delete the father node
+		{
+			typename set< Trie< Item > >::iterator tmp = runners.back()++ ;
+			sets.back()->erase( tmp ) ;
+		}
+		else
+			runners.back()++ ;
+	}
+
+	itemset.back() = runners.back()->getId() ;
+
+	descend() ;
+
+	return true ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that delete the current itemset from the trie
+*  the nodes of the path that have no more children are
+*  deleted when the iterator go up
+*/
+
+template< class Item >
+void TrieIterator< Item >::erase()
+{
+	typename set< Trie< Item > >::iterator tmp = runners.back()++ ;
+	sets.back()->erase( tmp ) ;
+
+	erased = true ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+// instantiation for the item identifiers on 8, 16 and 32 bits
+
+template class TrieIterator< unsigned char > ;
+template class TrieIterator< short unsigned > ;
+template class TrieIterator< unsigned int > ;
@@ -0,0 +1,130 @@
+/*----------------------------------------------------------------------
+  File    : TrieIterator.h
+  Contents: Class that go through the itemsets stored in a prefix trie
+            in depth first order with an explicit stack (no recursion).
+            The items of the current itemset are stored in a buffer
+            reused for all the itemsets of the trie
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#ifndef TRIEITERATOR_H
+#define TRIEITERATOR_H
+
+#include "Trie.h"
+
+template< class Item >
+class TrieIterator
+{
+protected:
+
+	// ---------------------------------------------
+	// stack of the sets of child nodes being
+	// processed, one set for each item of the
+	// current itemset
+	// ---------------------------------------------
+
+	vector< set< Trie< Item > > * > sets ;
+
+	// ----------------------------------------------
+	// stack of the positions in the sets of "sets"
+	// ----------------------------------------------
+
+	vector< typename set< Trie< Item > >::iterator > runners ;
+
+	// --------------------------------------------
+	// buffer storing the items of the itemset
+	// represented by the path to the current node
+	// --------------------------------------------
+
+	vector< Item > itemset ;
+
+	// ------------------------------------
+	// root of the trie being gone through
+	// ------------------------------------
+
+	Trie< Item > * root ;
+
+	// ---------------------------------------------
+	// maximal depth of the nodes, the nodes at this
+	// depth are considered as leaves
+	// ( -1 if there is no limit )
+	// ---------------------------------------------
+
+	int maxDepth ;
+
+	// ----------------------------------------------
+	// true if the current node has been erased, ie
+	// the runner at the top of the stack is already
+	// on the next node
+	// ----------------------------------------------
+
+	bool erased ;
+
+	bool started ;
+
+	// ------------------------------------------
+	// method that go down from the current node
+	// to the first leaf of its sub tree
+	// ------------------------------------------
+
+	void descend() ;
+
+	void push( set< Trie< Item > > * items ) ;
+
+public:
+
+	TrieIterator( Trie< Item > * inRoot = 0, int inMaxDepth = -1 ) ;
+
+	// --------------------------------------------------
+	// method that restart the iterator on a new trie
+	// the buffers are kept so that an iterator can be
+	// reused without new allocations
+	// --------------------------------------------------
+
+	void reset( Trie< Item > * inRoot, int inMaxDepth = -1 ) ;
+
+	// ------------------------------------------------
+	// method that move to the next itemset (leaf)
+	// return false when all the itemsets have been
+	// processed
+	// ------------------------------------------------
+
+	bool next() ;
+
+	// -----------------------------------------
+	// method returning the current itemset and
+	// the node of its last item
+	// -----------------------------------------
+
+	vector< Item > * getItemset() { return &itemset ; }
+
+	int getSize() const { return itemset.size() ; }
+
+	Trie< Item > * getNode() const { return const_cast< Trie< Item > * >( &(*runners.back()) ) ; }
+
+	// --------------------------------------------------
+	// method that delete the current itemset from the
+	// trie. the nodes of the path that have no more
+	// children are deleted when the iterator go up
+	// --------------------------------------------------
+
+	void erase() ;
+
+};
+
+// --------------------------------------------------------
+// function applying a visitor to all the itemsets of a
+// trie, the visitor is called with the itemset and the
+// node of its last item :   visitor( itemset, node )
+// --------------------------------------------------------
+
+template< class Item, class Visitor >
+void visitItemsets( Trie< Item > * root, Visitor & visitor, int maxDepth = -1 )
+{
+	TrieIterator< Item > it( root, maxDepth ) ;
+
+	while( it.next() )
+		visitor( it.getItemset(), it.getNode() ) ;
+}
+
+#endif
@@ -6,25 +6,77 @@
 
 #include "Zigzag.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 // ----------------------------------------------------------------------------------------------
 
 /**
 *  default constructor
 */
 
-Zigzag::Zigzag():Application()
+template< class Item >
+Zigzag< Item >::Zigzag():Application< Item >()
 {
 	ratioNfC = 0 ;
 
+	dualisation = DUAL_DT ;
+
+	nbThreads = 1 ;
+
+	edgeOrder = ORDER_LEX ;
+
+	complBatch = 16384 ;
+
+	memoryBudget = 0 ;
+
+	spillDir = "." ;
+
+	dumpPrefix = 0 ;
+
+	nbDumps = 0 ;
+
+	scheduler = 0 ;
+
+	streaming = false ;
+
+	outputMode = SINK_WRITE ;
+
+	binaryOutput = false ;
+
+	stopPoint = 0 ;
+
+	nbNegLeft = 0 ;
+
+	nbTrLeft = 0 ;
+
+	nbOptLeft = 0 ;
+
+	checkpointFile = 0 ;
+
+	checkpointSeconds = 0 ;
+
+	nextCheckpoint = 0 ;
+
+	resumeFile = 0 ;
+
+	bound = 0 ;
+
+	stateFile = 0 ;
+
+	updateFile = 0 ;
+
 	maxBdP = 0 ;
 
 	avgBdP = 0 ;
 	
-	bdN = new Trie(0) ;
+	bdN = new Trie< Item >(0) ;
 
-	bdP = new Trie(0);
+	bdP = new Trie< Item >(0);
 
-	bdPapriori = new Trie( 0 ) ;
+	bdPapriori = new Trie< Item >( 0 ) ;
 
 }
 
@@ -34,12 +86,12 @@ Zigzag::Zigzag():Application()
 *  default destructor
 */
 
-Zigzag::~Zigzag()
+template< class Item >
+Zigzag< Item >::~Zigzag()
 {
 
 	if( bdPapriori )
 	{
-		bdPapriori->deleteChildren();
 		delete bdPapriori;
 		bdPapriori = 0 ;
 	}
@@ -53,17 +105,16 @@ Zigzag::~Zigzag()
 *  method that execute the algrithm zigzag
 */
 
-int Zigzag::run()
+template< class Item >
+int Zigzag< Item >::run()
 {
-	Trie * complSet = 0 ;
+	Trie< Item > * opt=  new Trie< Item >( 0 );	// store all the itemsets that are closed to the positive border
 
+	Trie< Item > * transv = 0 ;
 
+	Trie< Item > * freqTr = 0 ;
 
-	Trie * opt=  new Trie( 0 );	// store all the itemsets that are closed to the positive border
-
-	Trie * transv = 0 ;
-
-	Trie * freqTr = 0 ;
+	Mmcs< Item > * hyper = 0 ;	// edges of the hypergraph for MMCS
 
 	
 	int sets ; // number of frequent itemset found by the levelwise approach
@@ -72,6 +123,9 @@ int Zigzag::run()
 				 // which are frequent or their error is <= eps
 
 	int totGen ; // total number of itemset in the optimist border
+
+	unsigned int nbRemoved = 0 ; // number of edges including another edge
+								 // ( then of non maximal itemsets of Bd+ )
 	
     bool generatedFk = false ; // true if | Fk | is not null
 
@@ -79,25 +133,126 @@ int Zigzag::run()
 
 	clock_t start ;
 
+	// sizes and time of the last dualisation, logged with the
+	// time of the counting of its complements by the scheduler
+
+	unsigned long nbEdges = 0, sumSizes = 0, nbCand ;
+
+	clock_t countStart ;
+
+	double dualSeconds = 0 ;
+
+	bool jumpPending = false ;
+
+	bool resumed = false ;	// true if the state is read from a snapshot
+
+	int promoted = -1 ;	// size of the smallest itemset of Bd- that became
+						// frequent if the borders of a previous run are updated
+
 	start = clock();
 
-	relist = new set< Element >;
-	
-	// execution of apriori Borgelt until a certain level k conditionned by ratioNfC
+	budget.start() ;
+
+	nextCheckpoint = checkpointSeconds ;
+
+	if( ( checkpointFile != 0 || resumeFile != 0 ) && ( dualisation == DUAL_MMCS ) )
+	{
+		// the edges kept by MMCS are not in the snapshots
+
+		cerr << "no snapshot with the dualisation MMCS" << endl;
+
+		checkpointFile = 0 ;
+		resumeFile = 0 ;
+	}
+
+	if( resumeFile != 0 )
+	{
+		resumed = loadSnapshot( transv, freqTr, opt, stat ) ;
+
+		if( ! resumed )
+			cerr << "can't resume from the snapshot " << resumeFile << endl;
+	}
+
+	if( resumed )
+	{
+		// the levelwise phase is done, only the
+		// transaction tree is rebuilt
+
+		tatree = apriori_tree( verbose ) ;
+
+		generatedFk = true ;
+	}
+	else if( ( updateFile != 0 ) && ( ( promoted = updateBorders( stat ) ) >= 0 ) )
+	{
+		// the borders are up to date if no itemset became
+		// frequent, otherwise the transactions are read again
+		// and the new frequent itemsets are searched from the
+		// rest of Bd- like after the levelwise phase ( the
+		// itemsets smaller than the promoted ones are known )
+
+		if( promoted > 0 )
+		{
+			k = promoted ;
+
+			initK = k ;
+
+			generatedFk = true ;
+
+			// the itemsets of the previous Bd+ may be
+			// no more maximal, they are written at the end
+
+			streaming = false ;
+		}
+		else
+			k = 0 ;
+	}
+	else
+	{
+		if( updateFile != 0 )
+			cerr << "can't update the borders of " << updateFile << ", all the itemsets are searched" << endl;
+
+		// execution of apriori Borgelt until a certain level k conditionned by ratioNfC
+		// ( the transactions have been loaded by apriori_load )
+
+		tatree = apriori( 0, minsup, k, bdPapriori, bdN, ratioNfC, eps, k, stat, maxBdP, generatedFk, verbose, scheduler );
 
-	tatree = apriori( fileName,0, minsup, k, bdPapriori, bdN, relist, ratioNfC, eps, k, stat, maxBdP, generatedFk, verbose );
+		initK = k ;
+	}
 
    if( verbose ) cout<<"Minsup : "<<minsup<<"\t Ratio or Level : "<<ratioNfC<<"\t Erreur :"<<eps<<endl;
 	
-	remap = new short unsigned[ relist->size() ];
-
-	initK = k ;
+	remap = new int[ relist->size() ];
 	
 	for( set<Element>::iterator itRelist = relist->begin(); itRelist != relist->end() ; itRelist++ )
 	{
 		remap[ itRelist->id ] = itRelist->oldid; 
 	}
 
+	// the levels of apriori are complete, the itemsets
+	// of its positive border are maximal and written now
+
+	if( streaming && ! saveFile.empty() )
+	{
+		if( ! stream.open( saveFile.c_str(), remap, relist->size(), outputMode, binaryOutput ) )
+			cerr << "can't open the output file " << saveFile << endl;
+
+		TrieIterator< Item > itApriori( bdPapriori ) ;
+
+		while( ( bdPapriori->getChildren() != 0 ) && itApriori.next() )
+			stream.push( itApriori.getItemset(), itApriori.getNode()->getSupport() ) ;
+
+		// the positive border read from a snapshot
+
+		auto pushCompact = [ this ]( vector< Item > * itemset, unsigned int support ) { stream.push( itemset, support ) ; } ;
+
+		compactBdPapriori.visitItemsets( pushCompact ) ;
+
+		TrieIterator< Item > itBdP( bdP ) ;
+
+		while( ( bdP->getChildren() != 0 ) && itBdP.next() )
+			stream.push( itBdP.getItemset(), itBdP.getNode()->getSupport() ) ;
+	}
+
 	
 	if(verbose)
 	{
@@ -109,72 +264,151 @@ int Zigzag::run()
 
 	if( k != 0 && generatedFk == true )
 	{
-		// Calculation of the transversals mins
-		// from the negative border of apriori
+		Hypergraph< Item > * edges ;
 
-		freqTr = new Trie( 0 ) ;
+		if( resumed )
+		{
+			// the transversals of the last dualisation, freqTr
+			// and opt have been read from the snapshot
 
-		start = clock();
+			if( verbose )
+				cout<<"Resumed at level "<<k<<" : Tr Min "<<transv->getSupport()<<"\t Bd+ size : "<<bdP->getSupport()<<endl;
+		}
+		else
+		{
+			// Calculation of the transversals mins
+			// from the negative border of apriori
+
+			freqTr = new Trie< Item >( 0 ) ;
+
+			// the positive border of apriori is only used for
+			// the final update so it is kept in a compact trie
+
+			compactBdPapriori.build( bdPapriori ) ;
+
+			bdPapriori->deleteChildren() ;
+
+			start = clock();
+
+			// we delete bd-
+			// since we don't keep the negative border
+			// but we use it to store the non frequent
+			// to be inserted in the hypergraph
+			// the edges are kept in an hypergraph during the dualization,
+			// without the edges including another edge and in the
+			// order chosen
+
+			edges = new Hypergraph< Item >( bdN ) ;
+
+			bdN->deleteChildren() ;
+
+			if( dumpPrefix != 0 )
+				edges->save( getDumpName().c_str(), relist->size(), k-1 ) ;
+
+			nbRemoved = edges->minimise() ;
+
+			edges->sort( edgeOrder ) ;
+
+			edges->setBitsets( dualisation == DUAL_DT ) ;
+
+			edges->setMemoryBudget( memoryBudget, spillDir ) ;
 
-		transv = bdN->trMinOpt( relist->size(), k-1 ) ;
+			if( dualisation == DUAL_MMCS )
+			{
+				// MMCS keeps all the edges and enumerate
+				// the minimal transversals from scratch
+
+				hyper = new Mmcs< Item >() ;
+
+				hyper->addEdges( edges ) ;
+
+				transv = hyper->trMinOpt( relist->size(), k-1 ) ;
+			}
+			else
+			{
+				transv = edges->trMinOpt( relist->size(), k-1, nbThreads ) ;
+
+				sumSizes = edges->getSumSizes() ;
 
-		// we delete bd-
-		// since we don't keep the negative border
-		// but we use it to store the non frequent
-		// to be inserted in the hypergraph
+				if( verbose )
+					cout<<"Edges : "<<edges->getNbEdges()<<" ( "<<nbRemoved<<" non minimal removed, "<<edges->getNbSpilled()<<" added on disk )"
+						<<"\t Tr Min max : "<<edges->getMaxSize()<<"\t total : "<<edges->getSumSizes()<<endl;
+			}
+
+			nbEdges = edges->getNbEdges() ;
+
+			dualSeconds = (clock()-start)/double(CLOCKS_PER_SEC) ;
+
+			jumpPending = true ;
 
-		bdN->deleteChildren() ;
+			if( dumpPrefix != 0 )
+				Hypergraph< Item >::saveResult( getDumpName().c_str(), transv ) ;
+
+			nbDumps++ ;
+
+			delete edges ;
+		}
 			
 		while( ( transv->getChildren() != 0 ) && ( ! transv->getChildren()->empty() ) )
 		{
+			// the state is saved at the beginning of
+			// an iteration, once the period is elapsed
 
-			if(verbose)
+			if( ( checkpointFile != 0 ) && ( budget.getElapsed() >= nextCheckpoint ) )
 			{
-                cout<<endl;
-				cout<<"Nb attributes : "<<relist->size()<<" Actual level (k) : "<<k<<endl;				
-				cout <<"Tr Min : "<< transv->getSupport() <<"   [" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
+				start = clock() ;
+
+				if( ! saveSnapshot( transv, freqTr, opt, stat ) )
+					cerr << "can't write the snapshot " << checkpointFile << endl;
+				else if( verbose )
+					cout<<"Snapshot saved in file "<<checkpointFile<<" [" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
+
+				nextCheckpoint = budget.getElapsed() + checkpointSeconds ;
 			}
 
-			// Generation of the complementaries
+			// safe point after a dualisation, the complements
+			// of its transversals are not counted
 
-			start = clock();
+			if( budget.exceeded() )
+			{
+				stopPoint = "dualisation" ;
 
-			if( transv->getSupport() != 0 )
-				complSet = transv->complem( relist->size() ) ;
-			
-			
-			if(verbose)
-				cout <<"Complement [" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
+				nbTrLeft = transv->getSupport() ;
 
-			
-			// Update of the support from the db
+				break ;
+			}
 
-			start = clock();
-			
-			countCandidates( complSet,tatree, k-1 );
-				
 			if(verbose)
-				cout <<"Complement support update [" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
+			{
+                cout<<endl;
+				cout<<"Nb attributes : "<<relist->size()<<" Actual level (k) : "<<k<<endl;				
+				cout <<"Tr Min : "<< transv->getSupport() <<"   [" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
+			}
 
-			// process of the optimist positive border 
+			// Generation of the complementaries, update of their
+			// support from the db and process of the optimist
+			// positive border by batches of complementaries
 			// ie all the itemsets frequent update Bd+, the
 			// non frequent with an error < "eps"
 			// are stored in opt and the others gennerates the sub sets of bad itemsets(in trie),
 			// it update also the set of transversal that generate
 			// max frequent itemset ( freqTr )
 
-			totGen = complSet->getSupport() ;
+			totGen = transv->getSupport() ;
 
 			start = clock();
 
-			trie = new Trie( 0 ) ;
-			nbFreq = processOptGenSub( complSet, opt, transv, freqTr, trie, k+1, stat ) ;
-			complSet->deleteChildren() ;
-			delete complSet ;
+			trie = new Trie< Item >( 0 ) ;
+			nbFreq = processComplements( transv, opt, freqTr, trie, k+1, stat ) ;
+
+			if( scheduler )
+				scheduler->jumped( k, nbEdges, sumSizes, totGen, dualSeconds, totGen, (clock()-start)/double(CLOCKS_PER_SEC) ) ;
+
+			jumpPending = false ;
 			
 			if(verbose)
 			{
-				cout <<"Bd+opt processing and sub itemsets generation[" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
+				cout <<"Complement, support update, Bd+opt processing and sub itemsets generation[" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
 				cout <<" : "<< nbFreq <<" itemsets are closed or in Bd+ on "<< totGen <<" itemsets generated"<<endl ;
 				cout<<"Bd+ size : "<<bdP->getSupport()<<endl;
 				cout<<"Opt size : "<<opt->getSupport()<<endl;
@@ -197,9 +431,16 @@ int Zigzag::run()
                 	cout<<"Generated wrt bd+ and opt: "<<trie->getSupport()<<" [" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
 
                 //candidates support update
+
+				nbCand = trie->getSupport() ;
+
+				countStart = clock();
                 	
 				countCandidates( trie,tatree, k+1 );
 
+				if( scheduler )
+					scheduler->counted( k+1, nbCand, (clock()-countStart)/double(CLOCKS_PER_SEC) ) ;
+
 				if(verbose) 
 				  	  cout <<"Support Update "<< trie->getSupport() << " [" << (clock()-start)/double(CLOCKS_PER_SEC) << "s] " << flush;
 
@@ -211,9 +452,6 @@ int Zigzag::run()
 				
 				nbFreq = pruneCandidates( trie, k+1);
 
-				trie->deleteChildren() ;
-				trie = 0 ;
-
 				k++;
     
 				if(verbose)
@@ -224,6 +462,21 @@ int Zigzag::run()
 
 			}
 
+			delete trie ;
+			trie = 0 ;
+
+			// safe point after the pruning of the candidates,
+			// the negative border found is not dualised
+
+			if( budget.exceeded() )
+			{
+				stopPoint = "candidates" ;
+
+				nbNegLeft = bdN->getSupport() ;
+
+				break ;
+			}
+
 			start = clock();
 
 			if( ! transv->getChildren()->empty() )  // if we can generate sets that are not
@@ -231,16 +484,72 @@ int Zigzag::run()
 			{
 				// dualization from the itemset of the negative border found at this iteration
 				
-				transv->trMinIopt( bdN , relist->size(), k-2, freqTr ) ;
+				edges = new Hypergraph< Item >( bdN ) ;
 
 				bdN->deleteChildren() ;
+
+				if( dumpPrefix != 0 )
+					edges->save( getDumpName().c_str(), relist->size(), k-2, transv, freqTr ) ;
+
+				nbRemoved = edges->minimise() ;
+
+				edges->sort( edgeOrder ) ;
+
+				edges->setBitsets( dualisation == DUAL_DT ) ;
+
+				edges->setMemoryBudget( memoryBudget, spillDir ) ;
+
+				if( dualisation == DUAL_MMCS )
+				{
+					// the transversals that generated frequent
+					// itemsets ( freqTr ) and their supersets are
+					// skipped, as in the incremental approach
+
+					if( edges->getNbEdges() != 0 )
+					{
+						hyper->addEdges( edges ) ;
+
+						delete transv ;
+
+						transv = hyper->trMinOpt( relist->size(), k-2, freqTr ) ;
+					}
+
+					sumSizes = 0 ;
+				}
+				else
+				{
+					edges->trMinIopt( transv, relist->size(), k-2, freqTr, nbThreads ) ;
+
+					sumSizes = edges->getSumSizes() ;
+
+					if( verbose )
+						cout<<"Edges : "<<edges->getNbEdges()<<" ( "<<nbRemoved<<" non minimal removed, "<<edges->getNbSpilled()<<" added on disk )"
+							<<"\t Tr Min max : "<<edges->getMaxSize()<<"\t total : "<<edges->getSumSizes()<<endl;
+				}
+
+				nbEdges = edges->getNbEdges() ;
+
+				dualSeconds = (clock()-start)/double(CLOCKS_PER_SEC) ;
+
+				jumpPending = true ;
+
+				if( dumpPrefix != 0 )
+					Hypergraph< Item >::saveResult( getDumpName().c_str(), transv ) ;
+
+				nbDumps++ ;
+
+				delete edges ;
 			}
 
 		}
 
-		freqTr->deleteChildren() ;
+		// the last dualisation found no transversal to count
+
+		if( scheduler && jumpPending )
+			scheduler->jumped( k, nbEdges, sumSizes, 0, dualSeconds, 0, 0 ) ;
+
+		delete hyper ;
 		delete freqTr ;
-		transv->deleteChildren() ;
 		delete transv;
 
 		if( verbose )
@@ -253,14 +562,14 @@ int Zigzag::run()
 
 		start = clock();
 
-		optApproach( opt, tatree, initK, stat ) ;
+		if( stopPoint == 0 )
+			nbOptLeft = optApproach( opt, tatree, initK, stat ) ;
+		else
+			nbOptLeft = opt->getSupport() ;
 
 		if(verbose)
 			cout<<"Optimist Approach [" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
 		
-    	opt->deleteChildren();
-    	delete opt;
-
 		if( verbose )
 		{
 			cout<<"Bd+ size : "<< bdP->getSupport()<<endl;
@@ -275,9 +584,16 @@ int Zigzag::run()
 		updateBdP() ;
 
 		if(verbose)
-		{
 			cout<<"Final update [" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
 
+		start = clock();
+
+		nbRemoved = filterBdP( stat ) ;
+
+		if(verbose)
+		{
+			cout<<"Maximality filter : "<<nbRemoved<<" non maximal removed [" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
+
 			cout<<"Bd+ size : "<<bdP->getSupport()<<endl;
 
 			cout<<"Size of the largest itemset in Bd+ : "<<maxBdP<<endl; 
@@ -289,6 +605,8 @@ int Zigzag::run()
 	}
 	else
 	{
+		delete bdP ;
+
 		bdP = bdPapriori ;
 
 		bdPapriori = 0 ;
@@ -300,18 +618,57 @@ int Zigzag::run()
 	    cout<<(*stat)[ l ] <<endl;	    
 	}    
 	
+	delete opt;
+
 	delete stat;
 
-	if( ! saveFile.empty() )
+	if( stream.isOpen() )
+	{
+		// the itemsets removed by the maximality
+		// filter have already been written
+
+		if( nbRemoved != 0 )
+			cerr << nbRemoved << " non maximal itemsets written in " << saveFile << endl;
+
+		stream.close() ;
+
+		if( verbose ) cout<<"Bd+ written during the run in file "<< saveFile.c_str() <<" : "<<stream.getNbItemsets()<<" itemsets"<< endl;
+	}
+	else if( ! saveFile.empty() )
 	{
 		start = clock() ;
 
-		bdP->saveItemsets( saveFile.c_str() , remap );
+		if( binaryOutput )
+		{
+			BorderWriter< Item > writer ;
+
+			if( writer.open( saveFile.c_str(), remap, relist->size(), outputMode ) )
+			{
+				visitItemsets( bdP, writer ) ;
+
+				writer.close() ;
+			}
+		}
+		else
+			bdP->saveItemsets( saveFile.c_str() , remap, outputMode );
 
 		if( verbose )cout<<"Saving Bd+ in file "<< saveFile.c_str() <<" [" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
 	}
 
+	// the negative border is the same if no itemset became frequent
+
+	if( ( stateFile != 0 ) && ( stopPoint == 0 ) )
+	{
+		start = clock() ;
+
+		if( ! saveState( ( promoted == 0 ) ? bdN : 0 ) )
+			cerr << "can't write the borders in file " << stateFile << endl;
+		else if( verbose )
+			cout<<"Borders saved in file "<<stateFile<<" [" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
+	}
 
+	if( budget.isSet() )
+		saveReport() ;
 	
 	return 1 ;
 }
@@ -319,305 +676,617 @@ int Zigzag::run()
 // ----------------------------------------------------------------------------------------------
 
 /**
-*  process the optimist positive border
-*  all the frequent update Bd+, the
-*  non frequent with an error < "eps"
-*  are stored in optIt and the others are keep in the set
-*  Note : complSet is the complement of the transversals mins
-*         optIt is a set of trie of itemsets which are closed to
-*          the positive border, all the itemset are stored
-*           with itemset of the same size in a trie, those 
-*           trie ared classified according to the size of 
-*           these itemsets
+*  method that write the state of the run, one value by line
+*  ( name=value ) : complete or stopped, the limit reached and
+*  the safe point where the run stopped, the time and memory
+*  used, the level reached, the number of maximal itemsets
+*  saved and the numbers of itemsets left at the safe point.
+*  The file is saveFile.report ( the standard output if there
+*  is no output file )
 */
 
-int Zigzag::processOptBorder(Trie * complSet, set< Trie > * optIt, Trie * tr, Trie * freqTr,
-                              vector< unsigned int > * stat  )
+template< class Item >
+void Zigzag< Item >::saveReport()
 {
+	ofstream pFile ;
 
-	int pruned;	// number of element deleted 
-				// ie number of itemsets frequent or near the positive border
+	ostream * out = &cout ;
 
-	vector< short unsigned > * tmp ;
-  
-	tmp = new vector< short unsigned > ;
+	if( ! saveFile.empty() )
+	{
+		pFile.open( ( saveFile + ".report" ).c_str() ) ;
 
-	pruned = complSet->getSupport() ;
+		if( ! pFile.is_open() )
+		{
+			cerr << "can't open the report " << saveFile << ".report" << endl;
+			return ;
+		}
 
-	processOptBorder( complSet->getChildren(),tmp, optIt, complSet, tr, freqTr, stat );
-	
-	pruned = pruned - complSet->getSupport() ;
+		out = &pFile ;
+	}
 
-	delete tmp;
+	*out<<"status="<<( stopPoint ? "stopped" : "complete" )<<endl;
 
-	return pruned;
+	if( stopPoint )
+	{
+		*out<<"reason="<<budget.getReason()<<endl;
+		*out<<"safe_point="<<stopPoint<<endl;
+	}
 
+	*out<<"seconds="<<budget.getElapsed()<<endl;
+	*out<<"resident_bytes="<<Budget::residentBytes()<<endl;
+	*out<<"level="<<k<<endl;
+	*out<<"maximal_itemsets="<<bdP->getSupport()<<endl;
+	*out<<"negative_border_left="<<nbNegLeft<<endl;
+	*out<<"transversals_left="<<nbTrLeft<<endl;
+	*out<<"optimist_itemsets_left="<<nbOptLeft<<endl;
 }
-	
-bool Zigzag::processOptBorder( set<Trie> *items, vector< short unsigned > *itemset, set< Trie > * optIt,
-							   Trie * complSet, Trie * tr ,Trie * freqTr, vector< unsigned int > * stat  )
-{
-	
-	if(items == 0) return 0;
 
-	set<Trie>::iterator tmp ;
+// ----------------------------------------------------------------------------------------------
 
-	bool del = true;
+/**
+*  method that write the state of the run at the beginning
+*  of an iteration of the dualisations : the threshold and
+*  the number of items ( checked on resume ), the level and
+*  the statistics, the borders, the positive border of
+*  apriori, the transversals of the last dualisation, the
+*  transversals that generated frequent itemsets and the
+*  itemsets of the optimist approach. The negative border
+*  is empty there, its itemsets are in the hypergraph
+*/
 
+template< class Item >
+bool Zigzag< Item >::saveSnapshot( Trie< Item > * transv, Trie< Item > * freqTr, Trie< Item > * opt, vector< unsigned int > * stat )
+{
+	SnapshotWriter< Item > writer ;
 
-	for(set<Trie>::iterator runner = items->begin(); runner != items->end(); )
-	{
-		itemset->push_back( runner->getId() );
+	if( ! writer.open( checkpointFile ) )
+		return false ;
 
-		if( ( runner->getChildren() == 0 ) || ( ( runner->getChildren() )->empty() ) )
-		{
+	writer.putNumber( minsup ) ;
+	writer.putNumber( relist->size() ) ;
 
+	writer.putNumber( k ) ;
+	writer.putNumber( initK ) ;
+	writer.putNumber( maxBdP ) ;
+	writer.putDouble( avgBdP ) ;
+	writer.putDouble( eps ) ;
+	writer.putNumber( nbDumps ) ;
 
-			if( runner->getSupport() < minsup )
-			{
+	writer.putNumber( stat->size() ) ;
 
-				if( error(runner->getSupport(), minsup ) <= eps ) // we are closed to the positive border
-				{
+	for( unsigned int i = 0; i < stat->size() ; i++ )
+		writer.putNumber( (*stat)[ i ] ) ;
 
-					tmp = optIt->find( Trie( itemset->size() ) );
+	writer.putTrie( bdP ) ;
+	writer.putTrie( bdN ) ;
+	writer.putTrie( compactBdPapriori ) ;
+	writer.putTrie( transv ) ;
+	writer.putTrie( freqTr ) ;
+	writer.putTrie( opt ) ;
 
-					if( tmp == optIt->end() )
-						tmp = optIt->insert( Trie( itemset->size() ) ).first ;
+	return writer.close() ;
+}
 
-					// the itemsets for the optimist approach
-					// are inserted into the good trie of optIt
+/**
+*  method that read the state written by saveSnapshot,
+*  transv and freqTr are created, the snapshot must have
+*  been taken on the same dataset with the same threshold
+*/
 
-					Trie * tmpT = const_cast< Trie * >( &(*tmp ) );
-					
-					tmpT->insert( itemset ) ; 
+template< class Item >
+bool Zigzag< Item >::loadSnapshot( Trie< Item > *& transv, Trie< Item > *& freqTr, Trie< Item > * opt, vector< unsigned int > * stat )
+{
+	SnapshotReader< Item > reader ;
 
-					
-					// we move the transversal assoicated with this itemset
-					// to the subset freqTr
-					// it avoid us to create subset of this itemset
+	int inK = k ;	// parameters of the run, kept if the snapshot is truncated
 
-					moveTransFreq( itemset, tr, freqTr )  ;
+	double inEps = eps ;
 
-					Trie * tmpT2 = const_cast< Trie * >( &(*runner ) );
-					     
-					tmpT2->deleteChildren();
-					tmp = runner++;
-					items->erase(tmp);
-					
-					complSet->Decrement() ;	// we decrement the number of itemset in complSet
+	if( ! reader.open( resumeFile ) )
+		return false ;
 
-				
-				}
-				else // the itemsets for the pessimist approach stay in complSet
-				{
+	if( ( reader.getNumber() != (unsigned long)minsup ) || ( reader.getNumber() != relist->size() ) )
+	{
+		cerr << "the snapshot " << resumeFile << " was taken on another dataset or threshold" << endl;
+		return false ;
+	}
 
-					runner++;
-					
-					del = false ;
-				}
+	k = reader.getNumber() ;
+	initK = reader.getNumber() ;
+	maxBdP = reader.getNumber() ;
+	avgBdP = reader.getDouble() ;
+	eps = reader.getDouble() ;
+	nbDumps = reader.getNumber() ;
 
-								
-			}
-			else
-			{
+	stat->resize( reader.getNumber() ) ;
 
-				// Update of the positive border 
+	for( unsigned int i = 0; i < stat->size() ; i++ )
+		(*stat)[ i ] = reader.getNumber() ;
 
-				bdP->insert( itemset,runner->getSupport() ) ;
-     
-				// update the size of the max and avg itemsets of bdP
+	transv = new Trie< Item >( 0 ) ;
 
-				if( maxBdP < itemset->size() ) 
-						maxBdP = itemset->size() ;
+	freqTr = new Trie< Item >( 0 ) ;
 
-				avgBdP = avgBdP + itemset->size() ;
-										  
-                (*stat)[ 0 ] ++;
-                (*stat)[ itemset->size()+1 ]++;
+	reader.getTrie( bdP ) ;
+	reader.getTrie( bdN ) ;
+	reader.getTrie( compactBdPapriori ) ;
+	reader.getTrie( transv ) ;
+	reader.getTrie( freqTr ) ;
+	reader.getTrie( opt ) ;
 
-				// we move the transversal assoicated with this itemset
-				// to the subset freqTr
-				// it avoid us to create subset of this itemset
+	if( reader.good() )
+		return true ;
 
-				moveTransFreq( itemset, tr, freqTr )  ;
-		
-				// we delete the itemset that is include in the positive border
+	// truncated snapshot, the run starts from the beginning
 
-				Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-				tmpT->deleteChildren();
-				tmp = runner++;
-				items->erase(tmp);
+	bdP->deleteChildren() ;
+	bdN->deleteChildren() ;
+	opt->deleteChildren() ;
 
-				complSet->Decrement() ;	// we decrement the number of itemset in complSet
+	bdP->setSupport( 0 ) ;
+	bdN->setSupport( 0 ) ;
+	opt->setSupport( 0 ) ;
 
-				
-			}
+	compactBdPapriori.clear() ;
+
+	delete transv ;
+	delete freqTr ;
+
+	transv = 0 ;
+	freqTr = 0 ;
+
+	stat->clear() ;
+
+	k = inK ;
+	eps = inEps ;
+	maxBdP = 0 ;
+	avgBdP = 0 ;
+	nbDumps = 0 ;
+
+	return false ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that write the borders of the run with their supports :
+*  the threshold, the number of transactions, the names of the
+*  items, Bd+ and Bd-. The negative border is the set of the
+*  minimal transversals of the complements of Bd+, its itemsets
+*  are counted in the db ( the transaction tree must not have
+*  been filtered, see apriori_keep )
+*/
+
+template< class Item >
+bool Zigzag< Item >::saveState( Trie< Item > * neg )
+{
+	SnapshotWriter< Item > writer ;
+
+	Trie< Item > * complements = 0 ;
+
+	Hypergraph< Item > * edges ;
+
+	bool res ;
+
+	if( ! writer.open( stateFile ) )
+		return false ;
+
+	writer.putNumber( minsup ) ;
+	writer.putNumber( apriori_tacnt() ) ;
+
+	writer.putNumber( relist->size() ) ;
+
+	for( unsigned int i = 0; i < relist->size() ; i++ )
+		writer.putNumber( remap[ i ] ) ;
+
+	writer.putTrie( bdP ) ;
+
+	if( neg == 0 )
+	{
+		complements = bdP->complem( relist->size() ) ;
+
+		// an itemset of Bd+ with all the items has an empty
+		// complement, all the itemsets are frequent
+
+		if( complements->getSupport() == bdP->getSupport() )
+		{
+			edges = new Hypergraph< Item >( complements ) ;
+
+			edges->minimise() ;
+
+			edges->setBitsets( dualisation == DUAL_DT ) ;
+
+			// all the minimal transversals are kept
+
+			neg = edges->trMinOpt( relist->size(), -1, nbThreads ) ;
+
+			delete edges ;
+
+			countCandidates( neg, tatree ) ;
 		}
 		else
-		{	
+			neg = new Trie< Item >( 0 ) ;
+
+		delete complements ;
+	}
+
+	writer.putTrie( neg ) ;
+
+	res = writer.close() ;
+
+	if( complements != 0 )
+		delete neg ;
+
+	return res ;
+}
+
+/**
+*  method that read the borders written by saveState and update
+*  them with the transactions appended since : their supports are
+*  counted on these transactions only. The itemsets of Bd+ and the
+*  itemsets of Bd- that became frequent are the positive border of
+*  the levelwise phase ( bdPapriori ), the others stay in Bd-, and
+*  the items that became frequent are added to bdPapriori. The
+*  items are recoded with their names. If some itemsets became
+*  frequent, the transaction tree of all the transactions is
+*  created, return the size of the smallest one ( 0 if none )
+*  or -1 if the borders can't be read
+*/
+
+template< class Item >
+int Zigzag< Item >::updateBorders( vector< unsigned int > * stat )
+{
+	SnapshotReader< Item > reader ;
+
+	Trie< Item > * oldBdP = new Trie< Item >( 0 ) ;	// borders with the new ids and
+														// the supports of the previous run
+	Trie< Item > * oldBdN = new Trie< Item >( 0 ) ;
+
+	Trie< Item > * read = new Trie< Item >( 0 ) ;
+
+	vector< int > newIds ;	// new id of each item of the previous run
+
+	vector< bool > known( relist->size(), false ) ;
+
+	vector< Item > itemset ;
+
+	TATREE * delta ;
+
+	unsigned long first ;	// first appended transaction
+
+	int res = 0 ;
+
+	bool good ;
+
+	// the itemsets are recoded and sorted again, those with
+	// an item that is no more frequent are not kept
+
+	auto recode = [ & ]( Trie< Item > * from, Trie< Item > * to )
+	{
+		TrieIterator< Item > it( from ) ;
+
+		unsigned int i ;
+
+		while( ( from->getChildren() != 0 ) && it.next() )
+		{
+			itemset.clear() ;
 
-			del = processOptBorder( runner->getChildren(), itemset, optIt, complSet, tr, freqTr, stat);
-      
-			if(	( del == true ) && 
+			for( i = 0; ( i < it.getItemset()->size() ) && ( (*it.getItemset())[ i ] < newIds.size() )
+						&& ( newIds[ (*it.getItemset())[ i ] ] >= 0 ) ; i++ )
+				itemset.push_back( newIds[ (*it.getItemset())[ i ] ] ) ;
 
-				( ( runner->getChildren() == 0 ) || ( (runner->getChildren())->empty() ) ))
-				// if all the children have beene deleted we delete the father node
+			if( i == it.getItemset()->size() )
 			{
-			    Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-			    
-				tmpT->deleteChildren();
-				tmp = runner++;
-				items->erase(tmp);				
-				
+				sort( itemset.begin(), itemset.end() ) ;
+
+				to->insert( &itemset, it.getNode()->getSupport() ) ;
 			}
-			else 
+		}
 
-				runner++;
-			
+		from->deleteChildren() ;
+	} ;
+
+	good = reader.open( updateFile ) && ( reader.getNumber() == (unsigned long)minsup ) ;
+
+	first = reader.getNumber() ;
+
+	if( good && ( first <= (unsigned long)apriori_tacnt() ) )
+	{
+		newIds.resize( reader.getNumber() ) ;
+
+		for( unsigned int i = 0; i < newIds.size() ; i++ )
+		{
+			set< Element >::iterator itRelist = relist->find( Element( reader.getNumber() ) ) ;
+
+			newIds[ i ] = ( itRelist != relist->end() ) ? itRelist->id : -1 ;
+
+			if( newIds[ i ] >= 0 )
+				known[ newIds[ i ] ] = true ;
 		}
-	
-		itemset->pop_back() ;
+
+		reader.getTrie( read ) ;
+		recode( read, oldBdP ) ;
+
+		reader.getTrie( read ) ;
+		recode( read, oldBdN ) ;
+
+		good = reader.good() ;
 	}
+	else
+		good = false ;
 
-	return del;
+	delete read ;
 
+	if( ! good )
+	{
+		cerr << "the borders of " << updateFile << " were not saved with this threshold on the beginning of this dataset" << endl;
 
-}
+		delete oldBdP ;
+		delete oldBdN ;
 
-int Zigzag::processOptBorder(Trie * complSet, Trie * opt, Trie * tr, Trie * freqTr,vector< unsigned int > * stat  )
-{
+		return -1 ;
+	}
 
-	int pruned;	// number of element deleted 
-				// ie number of itemsets frequent or near the positive border
+	// the supports are updated with the appended transactions
 
-	vector< short unsigned > * tmp ;
-  
-	tmp = new vector< short unsigned > ;
+	if( first < (unsigned long)apriori_tacnt() )
+	{
+		delta = apriori_delta( first, verbose ) ;
 
-	pruned = complSet->getSupport() ;
+		countCandidates( oldBdP, delta ) ;
+		countCandidates( oldBdN, delta ) ;
 
-	processOptBorder( complSet->getChildren(),tmp, opt, complSet, tr, freqTr, stat );
-	
-	pruned = pruned - complSet->getSupport() ;
+		tat_delete( delta ) ;
+	}
 
-	delete tmp;
+	stat->assign( relist->size() + 2, 0 ) ;
 
-	return pruned;
+	auto promote = [ & ]( vector< Item > * frequent, int supp )
+	{
+		bdPapriori->insert( frequent, supp ) ;
 
-}
-	
-bool Zigzag::processOptBorder( set<Trie> *items, vector< short unsigned > *itemset, Trie * opt,
-							   Trie * complSet, Trie * tr ,Trie * freqTr, vector< unsigned int > * stat  )
-{
-	
-	if(items == 0) return 0;
+		(*stat)[ 0 ]++ ;
+		(*stat)[ frequent->size() + 1 ]++ ;
+
+		if( maxBdP < (int)frequent->size() )
+			maxBdP = frequent->size() ;
+	} ;
+
+	TrieIterator< Item > itBdP( oldBdP ) ;
+
+	while( ( oldBdP->getChildren() != 0 ) && itBdP.next() )
+		promote( itBdP.getItemset(), itBdP.getNode()->getSupport() ) ;
+
+	TrieIterator< Item > itBdN( oldBdN ) ;
+
+	while( ( oldBdN->getChildren() != 0 ) && itBdN.next() )
+	{
+		if( itBdN.getNode()->getSupport() >= (unsigned int)minsup )
+		{
+			promote( itBdN.getItemset(), itBdN.getNode()->getSupport() ) ;
 
-	set<Trie>::iterator tmp ;
+			if( ( res == 0 ) || ( (int)itBdN.getItemset()->size() < res ) )
+				res = itBdN.getItemset()->size() ;
+		}
+		else
+			bdN->insert( itBdN.getItemset(), itBdN.getNode()->getSupport() ) ;
+	}
 
-	bool del = true;
+	for( unsigned int i = 0; i < known.size() ; i++ )
+		if( ! known[ i ] )
+		{
+			itemset.assign( 1, i ) ;
 
+			promote( &itemset, apriori_support( i ) ) ;
 
-	for(set<Trie>::iterator runner = items->begin(); runner != items->end(); )
+			res = 1 ;
+		}
+
+	if( res > 0 )
 	{
-		itemset->push_back( runner->getId() );
+		tatree = apriori_tree( verbose ) ;
+
+		// the dualisation of an empty Bd- gives only the empty
+		// transversal, so the set of all the items is counted :
+		// it is the only maximal itemset if it is frequent,
+		// otherwise it bounds the frequent itemsets
 
-		if( ( runner->getChildren() == 0 ) || ( ( runner->getChildren() )->empty() ) )
+		if( bdN->getSupport() == 0 )
 		{
+			Trie< Item > * all = new Trie< Item >( 0 ) ;
 
+			itemset.clear() ;
 
-			if( runner->getSupport() < minsup )
-			{
+			for( unsigned int i = 0; i < relist->size() ; i++ )
+				itemset.push_back( i ) ;
 
-				if( error(runner->getSupport(), minsup ) <= eps ) // we are closed to the positive border
-				{			
+			all->insert( &itemset, 0 ) ;
 
-					// the itemsets for the optimist approach
-					// are inserted stored in opt
-					opt->insert( itemset ) ; 
-					
-					// we move the transversal assoicated with this itemset
-					// to the subset freqTr
-					// it avoid us to create subset of this itemset
+			countCandidates( all, tatree ) ;
 
-					moveTransFreq( itemset, tr, freqTr )  ;
+			TrieIterator< Item > itAll( all ) ;
 
-					Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-					tmpT->deleteChildren();
-					tmp = runner++;
-					items->erase(tmp);
-					
-					complSet->Decrement() ;	// we decrement the number of itemset in complSet
+			itAll.next() ;
 
-				
-				}
-				else // the itemsets for the pessimist approach stay in complSet
-				{
-					runner++;
-					
-					del = false ;
-				}
-							
-			}
+			if( itAll.getNode()->getSupport() >= (unsigned int)minsup )
+				promote( &itemset, itAll.getNode()->getSupport() ) ;
 			else
+				bdN->insert( &itemset, itAll.getNode()->getSupport() ) ;
+
+			delete all ;
+		}
+	}
+
+	if( verbose )
+		cout<<"Borders updated : Bd+ "<<oldBdP->getSupport()<<"\t Bd- "<<oldBdN->getSupport()<<"\t became frequent : "
+			<<bdPapriori->getSupport() - oldBdP->getSupport()<<endl;
+
+	delete oldBdP ;
+	delete oldBdN ;
+
+	return res ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  process the optimist positive border
+*  all the frequent update Bd+, the
+*  non frequent with an error < "eps"
+*  are stored in optIt and the others are keep in the set
+*  Note : complSet is the complement of the transversals mins
+*         optIt is a set of trie of itemsets which are closed to
+*          the positive border, all the itemset are stored
+*           with itemset of the same size in a trie, those 
+*           trie ared classified according to the size of 
+*           these itemsets
+*/
+
+template< class Item >
+int Zigzag< Item >::processOptBorder(Trie< Item > * complSet, set< Trie< Item > > * optIt, Trie< Item > * tr, Trie< Item > * freqTr,
+                              vector< unsigned int > * stat  )
+{
+
+	int pruned;	// number of element deleted 
+				// ie number of itemsets frequent or near the positive border
+
+	TrieIterator< Item > it( complSet ) ;
+
+	vector< Item > * itemset ;
+
+	typename set< Trie< Item > >::iterator tmp ;
+
+	int supp ;
+
+	pruned = complSet->getSupport() ;
+
+	while( it.next() )
+	{
+		itemset = it.getItemset() ;
+
+		supp = it.getNode()->getSupport() ;
+
+		if( supp < minsup )
+		{
+
+			if( error( supp, minsup ) <= eps ) // we are closed to the positive border
 			{
 
-				// Update of the positive border 
-				
-				bdP->insert( itemset,runner->getSupport() ) ;
-     
-				// update the size of the max and avg itemsets of bdP
+				tmp = optIt->find( Trie< Item >( itemset->size() ) );
+
+				if( tmp == optIt->end() )
+					tmp = optIt->insert( Trie< Item >( itemset->size() ) ).first ;
 
-				if( maxBdP < itemset->size() ) 
-						maxBdP = itemset->size() ;
+				// the itemsets for the optimist approach
+				// are inserted into the good trie of optIt
 
-				avgBdP = avgBdP + itemset->size() ;
-								  
-                (*stat)[ 0 ] ++;
-                (*stat)[ itemset->size()+1 ]++;
+				Trie< Item > * tmpT = const_cast< Trie< Item > * >( &(*tmp ) );
+				
+				tmpT->insert( itemset ) ; 
 
 				// we move the transversal assoicated with this itemset
 				// to the subset freqTr
 				// it avoid us to create subset of this itemset
 
 				moveTransFreq( itemset, tr, freqTr )  ;
-		
-				// we delete the itemset that is include in the positive border
-
-				Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-				tmpT->deleteChildren();
-				tmp = runner++;
-				items->erase(tmp);
 
-				complSet->Decrement() ;	// we decrement the number of itemset in complSet
+				it.erase() ;
 				
+				complSet->Decrement() ;	// we decrement the number of itemset in complSet
 			}
+
+			// else the itemsets for the pessimist approach stay in complSet
 		}
 		else
-		{	
+		{
+			updateBdP( itemset, supp, stat ) ;
 
-			del = processOptBorder( runner->getChildren(), itemset, opt, complSet, tr, freqTr, stat );
-      
-			if(	( del == true ) && 
-				( ( runner->getChildren() == 0 ) || ( (runner->getChildren())->empty() ) ))
-				// if all the children have beene deleted we delete the father node
-			{
-			    Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-				tmpT->deleteChildren();
-				tmp = runner++;
-				items->erase(tmp);				
+			// we move the transversal assoicated with this itemset
+			// to the subset freqTr
+			// it avoid us to create subset of this itemset
+
+			moveTransFreq( itemset, tr, freqTr )  ;
+	
+			// we delete the itemset that is include in the positive border
+
+			it.erase() ;
+
+			complSet->Decrement() ;	// we decrement the number of itemset in complSet
+		}
+	}
+	
+	pruned = pruned - complSet->getSupport() ;
+
+	return pruned;
+
+}
+
+template< class Item >
+int Zigzag< Item >::processOptBorder(Trie< Item > * complSet, Trie< Item > * opt, Trie< Item > * tr, Trie< Item > * freqTr,vector< unsigned int > * stat  )
+{
+
+	int pruned;	// number of element deleted 
+				// ie number of itemsets frequent or near the positive border
+
+	TrieIterator< Item > it( complSet ) ;
+
+	vector< Item > * itemset ;
+
+	int supp ;
+
+	pruned = complSet->getSupport() ;
+
+	while( it.next() )
+	{
+		itemset = it.getItemset() ;
+
+		supp = it.getNode()->getSupport() ;
+
+		if( supp < minsup )
+		{
+
+			if( error( supp, minsup ) <= eps ) // we are closed to the positive border
+			{			
+
+				// the itemsets for the optimist approach
+				// are inserted stored in opt
+				opt->insert( itemset ) ; 
 				
+				// we move the transversal assoicated with this itemset
+				// to the subset freqTr
+				// it avoid us to create subset of this itemset
+
+				moveTransFreq( itemset, tr, freqTr )  ;
+
+				it.erase() ;
+				
+				complSet->Decrement() ;	// we decrement the number of itemset in complSet
 			}
-			else 
 
-				runner++;
-			
+			// else the itemsets for the pessimist approach stay in complSet
 		}
+		else
+		{
+			updateBdP( itemset, supp, stat ) ;
+
+			// we move the transversal assoicated with this itemset
+			// to the subset freqTr
+			// it avoid us to create subset of this itemset
+
+			moveTransFreq( itemset, tr, freqTr )  ;
 	
-		itemset->pop_back() ;
-	}
+			// we delete the itemset that is include in the positive border
 
-	return del;
+			it.erase() ;
 
+			complSet->Decrement() ;	// we decrement the number of itemset in complSet
+		}
+	}
+	
+	pruned = pruned - complSet->getSupport() ;
+
+	return pruned;
 
 }
 
@@ -625,160 +1294,171 @@ bool Zigzag::processOptBorder( set<Trie> *items, vector< short unsigned > *items
 // ----------------------------------------------------------------------------------------------
 
 /**
-*  process the optimist positive border: all the frequent update Bd+, the non frequent 
-*  with an error < "eps" are stored in optIt and the others generate the subsets (of size "size")
-*  of the infrequent itemsets "far" from the positive border for the generating candidate
+*  generate the complements of the transversals of tr by batches of complBatch
+*  itemsets, update their support from the db and process each batch with
+*  processOptGenSub, so the trie of all the complements is never stored
+*  the transversals to move to freqTr are kept in a trie and moved once
+*  tr has been gone through
 */
 
-int Zigzag::processOptGenSub(Trie * complSet, Trie  * opt, Trie * tr, Trie * freqTr,
-							 Trie * subSet, int size, vector< unsigned int > * stat  )
+template< class Item >
+int Zigzag< Item >::processComplements( Trie< Item > * tr, Trie< Item > * opt, Trie< Item > * freqTr,
+							 Trie< Item > * subSet, int size, vector< unsigned int > * stat )
 {
+	int nbFreq = 0 ;	// number of itemsets frequent or near the positive border
 
-	int nbFreq;	// number of element deleted 
-				// ie number of itemsets frequent or near the positive border
+	Trie< Item > * batch = new Trie< Item >( 0 ) ;	// complements of the current batch
 
-	vector< short unsigned > * tmp ;
-  
-	tmp = new vector< short unsigned > ;
+	Trie< Item > * moved = new Trie< Item >( 0 ) ;	// transversals to move to freqTr
 
-	nbFreq = bdP->getSupport() + opt->getSupport() ;
+	vector< Item > * comp = new vector< Item >() ;
 
-	processOptGenSub( complSet->getChildren(),tmp, opt, complSet, tr, freqTr, subSet, size, stat  );
-	
-	nbFreq = bdP->getSupport() + opt->getSupport()  - nbFreq ;
+	TrieIterator< Item > it( tr ) ;
 
-	delete tmp;
+	bool last = false ;
 
-	return nbFreq;
+	while( ! last )
+	{
+		last = ! it.next() ;
 
-}
-	
-bool Zigzag::processOptGenSub( set<Trie> *items, vector< short unsigned > *itemset, Trie * opt,
-							   Trie * complSet, Trie * tr ,Trie * freqTr, Trie * subSet, int size,
-                               vector< unsigned int > * stat  )
-{
-	
-	if(items == 0) return 0;
+		if( ! last )
+		{
+			tr->complem( it.getItemset(), relist->size(), comp ) ;
 
-	set<Trie>::iterator tmp ;
+			if( comp->empty() == false )
+				batch->insert( comp ) ;
+		}
 
-	bool del = true;
+		if( ( batch->getSupport() >= complBatch ) || ( last && ( batch->getSupport() != 0 ) ) )
+		{
+			countCandidates( batch, tatree, k-1 ) ;
 
-	bool inserted ;
-	
+			nbFreq += processOptGenSub( batch, opt, 0, moved, subSet, size, stat ) ;
+
+			batch->deleteChildren() ;
+		}
+	}
 
-	for(set<Trie>::iterator runner = items->begin(); runner != items->end(); )
+	// the transversals which generate frequent itemsets or
+	// itemsets near the positive border are moved to freqTr
+
+	it.reset( moved ) ;
+
+	while( it.next() )
 	{
-		itemset->push_back( runner->getId() );
+		freqTr->insert( it.getItemset() ) ;
 
-		if( ( runner->getChildren() == 0 ) || ( ( runner->getChildren() )->empty() ) )
-		{
+		tr->deleteIt( it.getItemset() ) ;
+	}
 
-			if( runner->getSupport() < minsup )
-			{
+	delete comp ;
+	delete moved ;
+	delete batch ;
 
-				if( error(runner->getSupport(), minsup ) <= eps ) // we are closed to the positive border
-				{			
+	return nbFreq ;
+}
 
-					// the itemsets for the optimist approach
-					// are inserted stored in opt
-					opt->insert( itemset ) ; 
-					
-					// we move the transversal assoicated with this itemset
-					// to the subset freqTr
-					// it avoid us to create subset of this itemset
+// ----------------------------------------------------------------------------------------------
 
-					moveTransFreq( itemset, tr, freqTr )  ;
+/**
+*  process the optimist positive border: all the frequent update Bd+, the non frequent 
+*  with an error < "eps" are stored in optIt and the others generate the subsets (of size "size")
+*  of the infrequent itemsets "far" from the positive border for the generating candidate
+*/
 
-					Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-					tmpT->deleteChildren();
-					tmp = runner++;
-					items->erase(tmp);
-					
-					complSet->Decrement() ;	// we decrement the number of itemset in complSet
+template< class Item >
+int Zigzag< Item >::processOptGenSub(Trie< Item > * complSet, Trie< Item >  * opt, Trie< Item > * tr, Trie< Item > * freqTr,
+							 Trie< Item > * subSet, int size, vector< unsigned int > * stat  )
+{
 
-				
-				}
-				else // this "very" infrequent itemsets are used to generate subsets
-					 // for the candidate generation
-				{
+	int nbFreq;	// number of element deleted 
+				// ie number of itemsets frequent or near the positive border
 
-					subSet->genSubsets( itemset, size );
-					
-					Trie * tmpT = const_cast< Trie * >( &(*runner ) );
+	TrieIterator< Item > it( complSet ) ;
 
-					tmpT->deleteChildren();
-					tmp = runner++;
-					items->erase(tmp);
-					
-					complSet->Decrement() ;	// we decrement the number of itemset in complSet
-				}
+	vector< Item > * itemset ;
 
-								
-			}
-			else
-			{
+	int supp ;
 
-				// Update of the positive border 
-				
-				bdP->insert( itemset,runner->getSupport() ) ;
-				
-				// update the size of the max and avg itemsets of bdP
+	nbFreq = bdP->getSupport() + opt->getSupport() ;
+
+	while( it.next() )
+	{
+		itemset = it.getItemset() ;
 
-				if( maxBdP < itemset->size() ) 
-						maxBdP = itemset->size() ;
+		supp = it.getNode()->getSupport() ;
 
-				avgBdP = avgBdP + itemset->size() ;
+		if( supp < minsup )
+		{
 
-                (*stat)[ 0 ] ++;
-                (*stat)[ itemset->size()+1 ]++;
+			if( error( supp, minsup ) <= eps ) // we are closed to the positive border
+			{			
 
+				// the itemsets for the optimist approach
+				// are inserted stored in opt
+				opt->insert( itemset ) ; 
+				
 				// we move the transversal assoicated with this itemset
 				// to the subset freqTr
 				// it avoid us to create subset of this itemset
 
 				moveTransFreq( itemset, tr, freqTr )  ;
-		
-				// we delete the itemset that is include in the positive border
-
-				Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-				tmpT->deleteChildren();
-				tmp = runner++;
-				items->erase(tmp);
-
-				complSet->Decrement() ;	// we decrement the number of itemset in complSet
-
-				
 			}
-		}
-		else
-		{	
-
-			del = processOptGenSub( runner->getChildren(), itemset, opt, complSet, tr, freqTr,
-									subSet, size, stat  );
-      
-			if(	( del == true ) && 
-				( ( runner->getChildren() == 0 ) || ( (runner->getChildren())->empty() ) ))
-				// if all the children have beene deleted we delete the father node
+			else // this "very" infrequent itemsets are used to generate subsets
+				 // for the candidate generation
 			{
-			    Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-				tmpT->deleteChildren();
-				tmp = runner++;
-				items->erase(tmp);				
-				
+				subSet->genSubsets( itemset, size );
 			}
-			else 
+		}
+		else
+		{
+			updateBdP( itemset, supp, stat ) ;
 
-				runner++;
-			
+			// we move the transversal assoicated with this itemset
+			// to the subset freqTr
+			// it avoid us to create subset of this itemset
+
+			moveTransFreq( itemset, tr, freqTr )  ;
 		}
-	
-		itemset->pop_back() ;
+
+		// all the itemsets are processed so they are deleted from complSet
+
+		it.erase() ;
+
+		complSet->Decrement() ;	// we decrement the number of itemset in complSet
 	}
+	
+	nbFreq = bdP->getSupport() + opt->getSupport()  - nbFreq ;
 
-	return del;
+	return nbFreq;
 
+}
 
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that insert a frequent itemset in the positive border
+*  and update the statistics on the positive border
+*/
+
+template< class Item >
+void Zigzag< Item >::updateBdP( vector< Item > *itemset, int supp, vector< unsigned int > * stat ) 
+{
+	// Update of the positive border 
+	
+	bdP->insert( itemset, supp ) ;
+
+	stream.push( itemset, supp ) ;
+	
+	// update the size of the max and avg itemsets of bdP
+
+	if( maxBdP < itemset->size() ) 
+			maxBdP = itemset->size() ;
+
+	avgBdP = avgBdP + itemset->size() ;
+
+	(*stat)[ 0 ] ++;
+	(*stat)[ itemset->size()+1 ]++;
 }
 
 // ----------------------------------------------------------------------------------------------
@@ -790,9 +1470,10 @@ bool Zigzag::processOptGenSub( set<Trie> *items, vector< short unsigned > *items
 *  the original set of transversal (tr)
 */
 
-void Zigzag::moveTransFreq( vector< short unsigned > *itemset, Trie * tr,  Trie * freqTr ) 
+template< class Item >
+void Zigzag< Item >::moveTransFreq( vector< Item > *itemset, Trie< Item > * tr,  Trie< Item > * freqTr ) 
 {
-	vector< short unsigned > * comp;
+	vector< Item > * comp;
 		
 	// we search the transversal associated with this itemset
 
@@ -804,8 +1485,10 @@ void Zigzag::moveTransFreq( vector< short unsigned > *itemset, Trie * tr,  Trie
 	freqTr->insert( comp ) ;
 
 	// we delete this transvresal from the original set
+	// ( tr is 0 when the deletion is done later )
 
-	tr->deleteIt( comp ) ;
+	if( tr != 0 )
+		tr->deleteIt( comp ) ;
 
 	delete comp;
 
@@ -819,26 +1502,78 @@ void Zigzag::moveTransFreq( vector< short unsigned > *itemset, Trie * tr,  Trie
 *  and insert the itemset of bd+ found by apriori
 */
 
-void Zigzag::updateBdP() 
-{
-	vector< short unsigned > * vect ;
+template< class Item >
+void Zigzag< Item >::updateBdP() 
+{
+	vector< Item > * vect ;
+
+	vect = new vector<Item>() ;
+
+	clock_t start = clock();
+
+	start = clock();
+
+	if( bdPapriori->getChildren() != 0 )
+		bdP->merge( bdPapriori ) ;
+
+	compactBdPapriori.insertInto( bdP ) ;
+
+	compactBdPapriori.clear() ;
+
+	if(verbose)
+		cout <<"Update bd+ with all the max freq found \t[" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
+
+	delete vect ;
+
+}
+	
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  method that delete from the positive border the itemsets
+*  included into another one : all the itemsets are indexed
+*  ( numbered in the order of the trie ) and tested by
+*  nbThreads threads ( see SubsetIndex::flagNonMaximal )
+*/
+
+template< class Item >
+unsigned int Zigzag< Item >::filterBdP( vector< unsigned int > * stat ) 
+{
+	SubsetIndex< Item > index( bdP ) ;
+
+	vector< char > flags ;
+
+	unsigned int nbFlagged, num ;
+
+	vector< Item > * itemset ;
+
+	nbFlagged = index.flagNonMaximal( flags, nbThreads ) ;
+
+	if( nbFlagged == 0 )
+		return 0 ;
 
-	vect = new vector<short unsigned>() ;
+	TrieIterator< Item > it( bdP ) ;
 
-	clock_t start = clock();
+	for( num = 0; it.next() ; num++ )
+	{
+		if( flags[ num ] )
+		{
+			itemset = it.getItemset() ;
 
-	start = clock();
+			avgBdP = avgBdP - itemset->size() ;
 
-	if( bdPapriori->getChildren() != 0 )
-		bdP->merge( bdPapriori ) ;
+			(*stat)[ 0 ] -- ;
+			(*stat)[ itemset->size()+1 ]-- ;
 
-	if(verbose)
-		cout <<"Update bd+ with all the max freq found \t[" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
+			it.erase() ;
+		}
+	}
 
-	delete vect ;
+	bdP->setSupport( bdP->getSupport() - nbFlagged ) ;
 
+	return nbFlagged ;
 }
-	
+
 // ----------------------------------------------------------------------------------------------
 
 /**
@@ -849,29 +1584,33 @@ void Zigzag::updateBdP()
 *  the maximal itemset are inserted in Bd+
 *  and save the min non frequent, 
 *  until the level k
+*  the budget is checked after each level, return the
+*  number of itemsets whose subsets are not explored
+*  if it is exceeded ( 0 otherwise )
 */
 
-void Zigzag::optApproach( set< Trie > * optIt, TATREE * tat, int lvl, vector< unsigned int > * stat  ) 
+template< class Item >
+unsigned long Zigzag< Item >::optApproach( set< Trie< Item > > * optIt, TATREE * tat, int lvl, vector< unsigned int > * stat  ) 
 {
-	vector< short unsigned > * itemset ;
+	unsigned long nbLeft = 0 ;
 
-	set< Trie >::iterator runner ;
+	typename set< Trie< Item > >::iterator runner ;
 
-	set< Trie >::iterator runner2 ;
+	typename set< Trie< Item > >::iterator runner2 ;
 
-	set<Trie>::iterator tmp ;
+	typename set< Trie< Item > >::iterator tmp ;
 	
-	Trie tmpSet(0) ;
+	Trie< Item > * nextLev ;	// trie of optIt storing the itemsets of the next level
 
 	int nbfreq ;
 	
 	int level ;
 
+	unsigned int nbGen, nbCand ;	// number of subsets generated and kept wrt bd+
+
 	if( ! optIt->empty() )
 	{
 
-		itemset = new vector<short unsigned>() ;
-
 		// we search the actual the level
 		// ie we find the itemsets with the max size
 
@@ -896,199 +1635,321 @@ void Zigzag::optApproach( set< Trie > * optIt, TATREE * tat, int lvl, vector< un
 			
 			if( ( runner2 != optIt->begin() ) && ( ( --runner2 )->getId() == level - 1 ) )
 			{
-		
-				tmpSet.setChildren( runner2->getChildren() ) ;	
-				tmpSet.setSupport( runner2->getSupport() );
+				nextLev = const_cast< Trie< Item > * >( &(*runner2 ) ) ;
 		    }				
 			else
 			{
-				tmpSet.setChildren( new set<Trie>() ) ;
-
-				tmpSet.setId( level - 1 ) ;
+				nextLev = const_cast< Trie< Item > * >( &(*optIt->insert( Trie< Item >( level - 1 ) ).first ) ) ;
 
-				optIt->insert( tmpSet ) ;
+				nextLev->makeChildren() ;
 			}
 
 			clock_t start = clock();
   
-			// generation of the sub set of the itemsets of the current itemsets in optIt
-
-			optApproach( runner->getChildren(), itemset, &tmpSet, stat ) ;
-
-			if(verbose)
-				cout <<"\t subests generation : "<<tmpSet.getSupport() <<"\t[" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
-			start = clock();
-			
-			// we prune the itemsets included into an itemset of Bd+
-		
-			genCand( &tmpSet, bdP) ;
-				
-			if(verbose)
-				cout<<"\t Generated wrt bd+ an bd+opt : "<<tmpSet.getSupport()<<" [" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
-
-			start = clock();
+			// generation of the sub set of the itemsets of the current itemsets in optIt,
+			// pruning of the itemsets included into an itemset of Bd+, support update,
+			// pruning of the frequent and update of the positive border
 
-			// support update
-
-			countCandidates( &tmpSet,tat, level - 1 );			
+			nbfreq = optApproach( const_cast< Trie< Item > * >( &(*runner ) ), nextLev, tat, level - 1, stat, nbGen, nbCand ) ;
 
 			if(verbose)
-				cout <<"\t Supports update \t[" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
+			{
+				cout <<"\t subests generation : "<<nbGen<<"\t Generated wrt bd+ an bd+opt : "<<nbCand
+					<<"\t Supports update and frequent suppression \t[" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
+				cout <<"\t number of frequent itemsets : "<<nbfreq <<endl;
+				cout <<"\t Bd+ :"<<bdP->getSupport()<<endl; ;
+			}				
 
 			// we delete the old non frequent
 
-			Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-			tmpT->deleteChildren() ;
 			tmp = runner-- ;
 			optIt->erase( tmp ) ;
-			
-			// To keep in runner the actual number of itemets
-			tmpT = const_cast< Trie * >( &(*runner ) );
-			tmpT->setSupport( tmpSet.getSupport() );
-
-			start = clock();
 
-			// prune the frequent
-			// and update of the positive and negative border 
+			// safe point after a level, the itemsets
+			// above the level lvl are left
 
-			nbfreq = pruneCandidatesOpt( &tmpSet, stat ) ;
+			if( budget.exceeded() )
+			{
+				stopPoint = "optimist" ;
 
-			// To keep in runner the actual number of itemets
-			tmpT = const_cast< Trie * >( &(*runner ) );
-			tmpT->setSupport( tmpSet.getSupport() );
+				for( tmp = optIt->begin(); tmp != optIt->end() ; tmp++ )
+					if( tmp->getId() > lvl )
+						nbLeft += tmp->getSupport() ;
 
-			if(verbose)
-			{
-				cout <<"\t frequent suppression and Bd+opt update \t[" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
-				cout <<"\t number of frequent itemsets : "<<nbfreq <<endl;
-				cout <<"\t Bd+ :"<<bdP->getSupport()<<endl; ;
-			}				
+				break ;
+			}
 		
 			runner2 =  runner ;
 
 		}
-
-		delete itemset ;
 	}
+
+	return nbLeft ;
 }
 
-void Zigzag::optApproach( set< Trie > * items,  vector< short unsigned > * itemset, Trie * nextLev, vector< unsigned int > * stat ) 
+/**
+*  one level of the optimist approach : the immediate subsets
+*  of the itemsets of lev are generated in nextLev from the
+*  sub trees of lev, in the order of their first item ( each
+*  subset is inserted once by node of lev and not once by
+*  itemset, see Trie::addSubsets ). A subset begins with the
+*  first or the second item of its itemset so once the sub
+*  tree of lev of an item is processed, the sub trees of
+*  nextLev before the next item are complete. They are moved to
+*  parts taken by nbThreads threads ( processOptPart ) while
+*  the next subsets are generated, then the frequent itemsets
+*  of the parts update Bd+ in order and the infrequent ones
+*  are moved back to nextLev
+*  return the number of frequent found
+*/
+
+template< class Item >
+int Zigzag< Item >::optApproach( Trie< Item > * lev, Trie< Item > * nextLev, TATREE * tat, int level, vector< unsigned int > * stat,
+									unsigned int & nbGen, unsigned int & nbCand ) 
 {
+	set< Trie< Item > > * levChild = lev->getChildren() ;
+
+	set< Trie< Item > > * child = nextLev->makeChildren() ;
+
+	vector< OptPart * > parts ;		// parts in the order of their first item
+
+	unsigned int nextPart = 0 ;		// first part not taken by a thread
+
+	bool finished = false ;			// true once all the parts are created
+
+	mutex lock ;
+
+	condition_variable ready ;
+
+	vector< thread > workers ;
 
-	set<Trie>::iterator tmp ;
+	int nbfreq = 0 ;
 
-	if( ( items != 0 ) && ( !items->empty() ) )
+	// the threads take the parts in order until
+	// the generation is finished
+
+	auto work = [ & ]()
 	{
+		OptPart * part ;
 
-		for(set< Trie >::iterator runner = items->begin(); runner != items->end(); )
+		while( true )
 		{
-			
-			// we save the curent item of the itemset being processed
+			{
+				unique_lock< mutex > guard( lock ) ;
 
-			itemset->push_back( runner->getId() ) ;			
-			
-			// we continue searching with the next items
+				ready.wait( guard, [ & ]{ return ( nextPart < parts.size() ) || finished ; } ) ;
 
-			optApproach( runner->getChildren(), itemset, nextLev, stat ) ;
+				if( nextPart == parts.size() )
+					return ;
 
-			// deletion of the itemset
+				part = parts[ nextPart++ ] ;
+			}
+
+			processOptPart( part, tat, level ) ;
+		}
+	} ;
 
-			Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-			tmpT->deleteChildren();
-			tmp = runner++;
-			items->erase(tmp);
-					
+	// the sub trees of nextLev before item ( all of
+	// them if last ) are moved to new parts
 
-			itemset->pop_back() ;
-			
+	auto share = [ & ]( Item item, bool last )
+	{
+		OptPart * part ;
+
+		while( ! child->empty() && ( last || ( child->begin()->getId() < item ) ) )
+		{
+			part = new OptPart() ;
+
+			part->trie.makeChildren()->insert( child->extract( child->begin() ) ) ;
+
+			{
+				lock_guard< mutex > guard( lock ) ;
+
+				parts.push_back( part ) ;
+			}
+
+			ready.notify_one() ;
 		}
+	} ;
+
+	// the calling thread generates the subsets
+	// and then processes the parts left
+
+	for( int t = 1; t < nbThreads ; t++ )
+		workers.push_back( thread( work ) ) ;
+
+	while( ( levChild != 0 ) && ! levChild->empty() )
+	{
+		share( levChild->begin()->getId(), false ) ;
+
+		// we generate the immediate subsets of the itemsets of the sub tree
 	
+		nextLev->genImmediateSubsets( const_cast< Trie< Item > * >( &(*levChild->begin() ) ), level ) ;
+
+		// deletion of the sub tree
+
+		levChild->erase( levChild->begin() ) ;
 	}
-	else	// we have check all the items of the current itemset strored in vect			
+
+	lev->setSupport( 0 ) ;
+
+	share( 0, true ) ;
+
+	nbGen = nextLev->getSupport() ;
+
 	{
-			// we generate the immediate subsets of the itemset
-		
-			nextLev->genSubsets( itemset, itemset->size() - 1 ) ;
+		lock_guard< mutex > guard( lock ) ;
+
+		finished = true ;
 	}
 
-}
+	ready.notify_all() ;
 
-void Zigzag::optApproach( Trie * opt, TATREE * tat, int lvl, vector< unsigned int > * stat ) 
-{
-	vector< short unsigned > * vect ;
+	work() ;
 
-	set < Trie > * 	optIt= new set< Trie >() ;
-	
+	for( unsigned int t = 0; t < workers.size() ; t++ )
+		workers[ t ].join() ;
 
-	if( opt->getChildren() != 0 )
+	// the frequent update the positive border and
+	// the infrequent are kept for the next level
+
+	nbCand = nbGen ;
+
+	nextLev->setSupport( 0 ) ;
+
+	for( unsigned int p = 0; p < parts.size() ; p++ )
 	{
-		vect = new vector<short unsigned>() ;
+		for( unsigned int f = 0; f < parts[ p ]->frequent.size() ; f++ )
+			updateBdP( &parts[ p ]->frequent[ f ].first, parts[ p ]->frequent[ f ].second, stat ) ;
 
-		initOptApproach( opt->getChildren() , vect, optIt ) ;
+		nbfreq += parts[ p ]->frequent.size() ;
 
-		delete vect ;
+		nbCand -= parts[ p ]->nbRemoved ;
 
-		optApproach( optIt, tat, lvl, stat ) ;
+		parts[ p ]->trie.setSupport( parts[ p ]->nbInfrequent ) ;
 
-	}
+		nextLev->merge( &parts[ p ]->trie ) ;
 
-	for( set< Trie >::iterator runner = optIt->begin(); runner != optIt->end(); runner++ )
-	{
-	      Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-	    
-          tmpT->deleteChildren();
-	}	
-	delete optIt ;
-	
+		delete parts[ p ] ;
+	}
 
-		
+	return nbfreq ;
 }
 
-void Zigzag::initOptApproach( set< Trie > * items,  vector< short unsigned > * itemset, set< Trie > * optIt ) 
+/**
+*  the itemsets of the part included into an itemset of
+*  Bd+ are deleted, the supports of the others are updated
+*  and the frequent are moved to the list of the part ( Bd+
+*  is only read, it is updated once all the parts are done ).
+*  The itemsets that are not included into an itemset of
+*  the bound are set aside before the counting, they are
+*  infrequent
+*/
+
+template< class Item >
+void Zigzag< Item >::processOptPart( OptPart * part, TATREE * tat, int level ) 
 {
+	Trie< Item > * node ;
+
+	Trie< Item > outside( 0 ) ;	// itemsets not included into the bound
+
+	// genCand decrements the support of the part
+	// for each itemset deleted
 
-	set<Trie>::iterator tmp ;
+	genCand( &part->trie, bdP ) ;
 
-	if( ( items != 0 ) && ( !items->empty() ) )
+	part->nbRemoved = 0u - part->trie.getSupport() ;
+
+	if( ( bound != 0 ) && ( part->trie.getChildren() != 0 ) )
 	{
+		TrieIterator< Item > itBound( &part->trie ) ;
 
-		for(set< Trie >::iterator runner = items->begin(); runner != items->end(); )
+		while( itBound.next() )
 		{
-			
-			// we save the curent item of the itemset being processed
+			if( ! bound->includedIn( itBound.getItemset() ) )
+			{
+				outside.insert( itBound.getItemset() ) ;
 
-			itemset->push_back( runner->getId() ) ;			
-			
-			// we continue searching with the next items
+				itBound.erase() ;
 
-			initOptApproach( runner->getChildren(), itemset, optIt ) ;
+				part->nbInfrequent++ ;
+			}
+		}
+	}
 
-			// deletion of the itemset
+	countCandidates( &part->trie, tat, level ) ;
 
-			Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-			tmpT->deleteChildren();
-			tmp = runner++;
-			items->erase(tmp);
-					
+	TrieIterator< Item > it( &part->trie ) ;
 
-			itemset->pop_back() ;
-			
+	while( it.next() )
+	{
+		node = it.getNode() ;
+
+		if( node->getSupport() >= minsup )
+		{
+			part->frequent.push_back( make_pair( *it.getItemset(), node->getSupport() ) ) ;
+
+			it.erase() ;
 		}
+		else
+			part->nbInfrequent++ ;
+	}
+
+	if( outside.getChildren() != 0 )
+		part->trie.merge( &outside ) ;
+}
+
+template< class Item >
+unsigned long Zigzag< Item >::optApproach( Trie< Item > * opt, TATREE * tat, int lvl, vector< unsigned int > * stat ) 
+{
+	set < Trie< Item > > * 	optIt= new set< Trie< Item > >() ;
 	
+	unsigned long nbLeft = 0 ;
+
+	if( opt->getChildren() != 0 )
+	{
+		initOptApproach( opt, optIt ) ;
+
+		nbLeft = optApproach( optIt, tat, lvl, stat ) ;
+
 	}
-	else	// we have check all the items of the current itemset strored in vect			
-	{       // construction of the trees that regroup itemsets wrt their size
+
+	delete optIt ;
+	
+	return nbLeft ;
+		
+}
+
+template< class Item >
+void Zigzag< Item >::initOptApproach( Trie< Item > * opt, set< Trie< Item > > * optIt ) 
+{
+
+	typename set< Trie< Item > >::iterator tmp ;
+
+	TrieIterator< Item > it( opt ) ;
+
+	vector< Item > * itemset ;
+
+	while( it.next() )
+	{
+		// construction of the trees that regroup itemsets wrt their size
+
+		itemset = it.getItemset() ;
 	
-		tmp = optIt->find( Trie( itemset->size() ) );
+		tmp = optIt->find( Trie< Item >( itemset->size() ) );
 
 		if( tmp == optIt->end() )
-				tmp = optIt->insert( Trie( itemset->size() ) ).first ;
+				tmp = optIt->insert( Trie< Item >( itemset->size() ) ).first ;
 
 		// the itemsets for the optimist approach
 		// are inserted into the good trie of optIt
 
-		Trie * tmpT = const_cast< Trie * >( &(*tmp ) );
+		Trie< Item > * tmpT = const_cast< Trie< Item > * >( &(*tmp ) );
 		tmpT->insert( itemset ) ;
+
+		// deletion of the itemset
+
+		it.erase() ;
 	}
 
 }
@@ -1103,68 +1964,39 @@ void Zigzag::initOptApproach( set< Trie > * items,  vector< short unsigned > * i
 *  (used in the pess approach)
 */
 
-int Zigzag::pruneCandidates(Trie * tr, int level)
+template< class Item >
+int Zigzag< Item >::pruneCandidates(Trie< Item > * tr, int level)
 {
-  int pruned;
-  short unsigned *tmp = new short unsigned[level];
+	TrieIterator< Item > it( tr, level ) ;
 
-  pruned = pruneCandidates(level,tr->getChildren(),1,tmp ) ;
+	Trie< Item > * node ;
 
-  tr->setSupport( pruned ) ;
+	int left = 0;
 
-  delete [] tmp;
-  return pruned;
-}
+	while( it.next() )
+	{
+		if( it.getSize() == level )
+		{
+			node = it.getNode() ;
 
-int Zigzag::pruneCandidates( int level, set<Trie> *items, int depth, short unsigned *itemset )
-{
+			if( node->getSupport() < minsup )
+			{
+				// Update of the negative border 
+
+				bdN->insert( it.getItemset(), node->getSupport() ) ;
+
+				it.erase() ;
+			}
+			else
+				left++;
+		}
+		else	// the itemsets smaller than the candidates are deleted
+			it.erase() ;
+	}
+
+	tr->setSupport( left ) ;
 
-  if(items == 0) return 0;
-  int left = 0;
-
-  for(set<Trie>::iterator runner = items->begin(); runner != items->end(); )
-  {
-    itemset[depth-1] = runner->getId();
-
-    if(depth == level)
-    {
-      if(runner->getSupport() < minsup)
-      {
-		// Update of the negative border 
-
-		bdN->insert( itemset, level,runner->getSupport()  ) ;
-
-        Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-    	tmpT->deleteChildren();
-    	set<Trie>::iterator tmp = runner++;
-    	items->erase(tmp);
-      }
-      else
-      {
-		left++;
-
-		runner++;
-      }
-    }
-    else
-    {	
-      int now = pruneCandidates(level, runner->getChildren(), depth+1, itemset);
-      
-      if(now)
-      {
-         left += now;
-    	 runner++;
-      }
-      else
-      {
-         Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-         tmpT->deleteChildren();
-         set<Trie>::iterator tmp = runner++;
-         items->erase(tmp);
-      }
-    }
-  }
-  return left;
+	return left;
 }
 
 // ----------------------------------------------------------------------------------------------
@@ -1175,73 +2007,31 @@ int Zigzag::pruneCandidates( int level, set<Trie> *items, int depth, short unsig
 *  update Bd+ of the pessimist approach
 */
 
-int Zigzag::processCandTrans(Trie * tr, int level, Trie * transv, int n, int lvl, Trie * freqTr)
+template< class Item >
+int Zigzag< Item >::processCandTrans(Trie< Item > * tr, int level, Trie< Item > * transv, int n, int lvl, Trie< Item > * freqTr)
 {
-  int pruned;
-  vector< unsigned short> *tmp = new vector< short unsigned>;
-
-  pruned = processCandTrans(level,tr->getChildren(),1,tmp, transv, n, lvl, freqTr ) ;
+	TrieIterator< Item > it( tr, level ) ;
 
-  tr->setSupport( pruned ) ;
+	SubsetIndex< Item > freqIndex( freqTr ) ;
 
-  delete tmp;
-  return pruned;
-}
+	int left = 0;
 
-int Zigzag::processCandTrans( int level, set<Trie> *items, int depth, vector< unsigned short> *itemset,
-							 Trie * transv, int n, int lvl, Trie * freqTr )
-{
+	while( it.next() )
+	{
+		if( it.getSize() == level )
+		{
+			if( it.getNode()->getSupport() < minsup )
+				transv->trMinIopt( it.getItemset(), n, lvl, &freqIndex, nbThreads );
+			else
+				left++;
+		}
 
-  if(items == 0) return 0;
-  int left = 0;
+		it.erase() ;
+	}
 
-  for(set<Trie>::iterator runner = items->begin(); runner != items->end(); )
-  {
-    itemset->push_back( runner->getId() );
+	tr->setSupport( left ) ;
 
-    if(depth == level)
-	{
-      if(runner->getSupport() < minsup)
-	  {
-		
-		transv->trMinIopt( itemset, n, lvl, freqTr );
-
-        Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-		tmpT->deleteChildren();
-		set<Trie>::iterator tmp = runner++;
-		items->erase(tmp);
-      }
-      else {
-
-		left++;
-
-        Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-		tmpT->deleteChildren();
-		set<Trie>::iterator tmp = runner++;
-		items->erase(tmp);
-      }
-    }
-    else 
-	{	
-      int now = processCandTrans(level, runner->getChildren(), depth+1, itemset,
-								 transv, n, lvl, freqTr );
-      if(now)
-	  {
-		left += now;
-		runner++;
-	  }
-      else
-	  {
-	      Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-	      tmpT->deleteChildren();
-	      set<Trie>::iterator tmp = runner++;
-	      items->erase(tmp);
-      }
-    }
-	itemset->pop_back() ;
-  }
-
-  return left;
+	return left;
 }
 
 // ----------------------------------------------------------------------------------------------
@@ -1253,109 +2043,48 @@ int Zigzag::processCandTrans( int level, set<Trie> *items, int depth, vector< un
 *  return the number of frequent found
 */
 
-int Zigzag::pruneCandidatesOpt( Trie * tr, vector< unsigned int > * stat  )
+template< class Item >
+int Zigzag< Item >::pruneCandidatesOpt( Trie< Item > * tr, vector< unsigned int > * stat  )
 {
 	int nbnf =0 ;
 	int nbfreq =0 ;
 
-	vector< short unsigned > * tmp ;
-  
-	tmp = new vector< short unsigned > ;
-
-	nbfreq = tr->getSupport() ;
-
-	nbnf = pruneCandidatesOpt( tr->getChildren() , tmp, stat );
-
-	tr->setSupport(  nbnf ) ;
-
-	nbfreq = nbfreq -  nbnf ;
-
-	delete tmp;
-
-	return nbfreq;
-
-}
-	
-
-int Zigzag::pruneCandidatesOpt( set<Trie> *items, vector< short unsigned > *itemset, vector< unsigned int > * stat )
-{
-
-	set< Trie >::iterator runDel ;
+	TrieIterator< Item > it( tr ) ;
 
-	if(items == 0) return 0;
+	Trie< Item > * node ;
 
-	int left = 0;
+	nbfreq = tr->getSupport() ;
 
-	for(set<Trie>::iterator runner = items->begin(); runner != items->end(); )
+	while( it.next() )
 	{
-		itemset->push_back( runner->getId() );
-
-		// if we have find an itemset
-
-		if( ( runner->getChildren() == 0 ) || ( ( runner->getChildren() )->empty() ) )
-		{			
-
-			// we keep the non frequent itemset in the set
-			// we update tmp bd+ with the frequent
-			// and delete them from the set
-			// since we search the maximals frequents
+		node = it.getNode() ;
 
-			if(runner->getSupport() >= minsup)
-			{
-
-			   // update the size of the max and avg itemsets of bdP
-
-				if( maxBdP < itemset->size() ) 
-						maxBdP = itemset->size() ;
-
-				avgBdP = avgBdP + itemset->size() ;
-					  
-                (*stat)[ 0 ] ++;
-                (*stat)[ itemset->size()+1 ]++;
+		// we keep the non frequent itemset in the set
+		// we update tmp bd+ with the frequent
+		// and delete them from the set
+		// since we search the maximals frequents
 
-				// we insert the frequent in  Bd+ of the optimist approach
-				
-				bdP->insert( itemset, runner->getSupport() ) ;
+		if( node->getSupport() >= minsup )
+		{
+			// we insert the frequent in  Bd+ of the optimist approach
 
-				// the itemset is  frequent
-				// so we delete it
+			updateBdP( it.getItemset(), node->getSupport(), stat ) ;
 
-				Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-				tmpT->deleteChildren();
-				set<Trie>::iterator tmp = runner++;
-				items->erase(tmp);
-			}
-			else
-			{
+			// the itemset is  frequent
+			// so we delete it
 
-				left++;
-				runner++;
-			}
-			
-	    }
+			it.erase() ;
+		}
 		else
-		{
-			int now = pruneCandidatesOpt( runner->getChildren(), itemset, stat );
+			nbnf++;
+	}
 
-			if(now)
-			{
-				left += now;
-				runner++;
-			}
-			else 
-			{	
+	tr->setSupport(  nbnf ) ;
 
-                Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-				tmpT->deleteChildren();
-				set<Trie>::iterator tmp = runner++;
-				items->erase(tmp);
-			}
-		}
-		itemset->pop_back() ;
+	nbfreq = nbfreq -  nbnf ;
 
-	}
+	return nbfreq;
 
-	return left;
 }
 
 // ---------------------------------------------------------------------------------------------- 
@@ -1365,7 +2094,8 @@ int Zigzag::pruneCandidatesOpt( set<Trie> *items, vector< short unsigned > *item
 *  form the positive border
 */
 
-double Zigzag::error( int supp, int minSup )
+template< class Item >
+double Zigzag< Item >::error( int supp, int minSup )
 {
 	double err ;
 
@@ -1387,82 +2117,29 @@ double Zigzag::error( int supp, int minSup )
 *  itemset of Bd+ (bd)
 */
 
-void Zigzag::pruneCandBottomUp( Trie * tr, Trie * bd, Trie * opt ) 
+template< class Item >
+void Zigzag< Item >::pruneCandBottomUp( Trie< Item > * tr, Trie< Item > * bd, Trie< Item > * opt ) 
 {
-	vector< short unsigned > * vect ;
+	vector< Item > * vect ;
 
-	vect = new vector<short unsigned>() ;
-
-	if( tr->getChildren() != 0 && bd->getChildren() != 0)
-		pruneCandBottomUp( tr->getChildren(), bd , opt, vect, tr ) ;
-	
-	delete vect ;
-}
-
-
-
-bool Zigzag::pruneCandBottomUp( set< Trie > * items, Trie * bd, Trie * opt, vector< short unsigned > * vect, Trie * tr ) 
-{
-	set< Trie >::iterator tmp ;
+	if( tr->getChildren() == 0 || bd->getChildren() == 0)
+		return ;
 
-	bool res ;		
+	TrieIterator< Item > it( tr ) ;
 
-	if( ( items != 0 ) && ( !items->empty() ) )
+	while( it.next() )
 	{
+		vect = it.getItemset() ;
 
-		for(set< Trie >::iterator runner = items->begin(); runner != items->end();)
-		{
-			res = false ;
-
-			// we save the curent item of the itemset being processed
-
-			vect->push_back( runner->getId() ) ;
-			
-			// we continue searching with the next items
-
-			res = pruneCandBottomUp( runner->getChildren(), bd , opt, vect, tr ) ;
-			
-			// we delete the itemset inlcuded in an itemset of bd
-
-			if ( ( res == true ) &&  
-					( ( runner->getChildren() == 0 ) || ( (runner->getChildren())->empty() ) ) )
-				{
-				    Trie * tmpT = const_cast< Trie * >( &(*runner ) );
-					tmpT->deleteChildren() ;
-
-					tmp = runner ++ ;
-
-					items->erase( tmp ) ;
-				}
-				else
-					runner++ ;
-
-			vect->pop_back() ;
-				
-		}
-
-	}
-	else	// we have check all the items of the current itemset strored in vect
-	{
-	
-		res = bd->include( vect );
+		// we delete the itemset inlcuded in an itemset of bd
 
-		if( res == true )
+		if( ( bd->include( vect ) == true ) || ( opt->include( vect ) == true ) )
 		{
-
 			tr->setSupport( tr->getSupport() -1 );
-		}
-		else
-		{
-			res = opt->include( vect );
 
-			if( res == true )
-				tr->setSupport( tr->getSupport() -1 );
+			it.erase() ;
 		}
 	}
-
-	return res ;
-
 }
 
 // ----------------------------------------------------------------------------------------------  
@@ -1474,28 +2151,26 @@ bool Zigzag::pruneCandBottomUp( set< Trie > * items, Trie * bd, Trie * opt, vect
 *  bdp : set of itemsets of bd+ or near bd+ found by jumps
 */
 
-void Zigzag::genCand( Trie * subSet, Trie * inbdp )
+template< class Item >
+void Zigzag< Item >::genCand( Trie< Item > * subSet, Trie< Item > * inbdp )
 {
 	bool del = false ;
 
-	set< Trie >::iterator tmpIt ;
+	typename set< Trie< Item > >::iterator tmpIt ;
 
 	if( subSet != 0 && inbdp != 0 )
 	{
 
 	
-		set<Trie> * child = subSet->getChildren() ;
+		set< Trie< Item > > * child = subSet->getChildren() ;
 
-		for( set<Trie>::iterator itChild = child->begin(); itChild != child->end(); )
+		for( typename set< Trie< Item > >::iterator itChild = child->begin(); itChild != child->end(); )
 		{
-		    Trie * tmpT = const_cast< Trie * >( &(*itChild ) );
+		    Trie< Item > * tmpT = const_cast< Trie< Item > * >( &(*itChild ) );
 			del = genCand( tmpT, inbdp->getChildren(), subSet ) ;
 
 			if( del && ( itChild->getChildren() == 0 || itChild->getChildren()->empty()  ))
 			{
-			    Trie * tmpT = const_cast< Trie * >( &(*itChild ) );
-				tmpT->deleteChildren() ;
-
 				tmpIt = itChild ++ ;
 
 				child->erase( tmpIt ) ;
@@ -1507,11 +2182,12 @@ void Zigzag::genCand( Trie * subSet, Trie * inbdp )
 	}
 }
 
-bool Zigzag::genCand( Trie * subSet, set<Trie> * childbdp, Trie * tr )
+template< class Item >
+bool Zigzag< Item >::genCand( Trie< Item > * subSet, set< Trie< Item > > * childbdp, Trie< Item > * tr )
 {
 	bool del =false ;
 
-	set< Trie >::iterator tmpIt ;
+	typename set< Trie< Item > >::iterator tmpIt ;
 
 
 	if(subSet == 0 || childbdp == 0 || childbdp->empty() ) return del;
@@ -1520,7 +2196,7 @@ bool Zigzag::genCand( Trie * subSet, set<Trie> * childbdp, Trie * tr )
 
 	size = childbdp->size();            // get the number of children //
 
-	for( set<Trie>::iterator itChildbdp = childbdp->begin(); itChildbdp != childbdp->end() 
+	for( typename set< Trie< Item > >::iterator itChildbdp = childbdp->begin(); itChildbdp != childbdp->end() 
 		&& !(del  && ( subSet->getChildren() == 0 || subSet->getChildren()->empty() ))
 		; itChildbdp++ )
 	{
@@ -1537,19 +2213,16 @@ bool Zigzag::genCand( Trie * subSet, set<Trie> * childbdp, Trie * tr )
 			}
 			else
 			{
-				set<Trie> * child = subSet->getChildren() ;
+				set< Trie< Item > > * child = subSet->getChildren() ;
 
-				for( set<Trie>::iterator itChild = child->begin(); itChild != child->end();)
+				for( typename set< Trie< Item > >::iterator itChild = child->begin(); itChild != child->end();)
 				{
 
-	                Trie * tmpT = const_cast< Trie * >( &(*itChild ) );
+	                Trie< Item > * tmpT = const_cast< Trie< Item > * >( &(*itChild ) );
 					del = genCand(  tmpT, itChildbdp->getChildren(),tr );
 
 					if( del && ( itChild->getChildren() == 0 || itChild->getChildren()->empty() ) )
 					{
-					    Trie * tmpT = const_cast< Trie * >( &(*itChild ) );
-						tmpT->deleteChildren() ;
-
 						tmpIt = itChild ++ ;
 
 						child->erase( tmpIt ) ;
@@ -1577,3 +2250,11 @@ bool Zigzag::genCand( Trie * subSet, set<Trie> * childbdp, Trie * tr )
   return del;
 
 }
+
+// ----------------------------------------------------------------------------------------------
+
+// instantiation for the item identifiers on 8, 16 and 32 bits
+
+template class Zigzag< unsigned char > ;
+template class Zigzag< short unsigned > ;
+template class Zigzag< unsigned int > ;
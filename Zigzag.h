@@ -11,11 +11,52 @@
 #include "tract.h"
 
 #include "Application.h"
-
-
-class Zigzag: public Application 
+#include "TrieIterator.h"
+#include "CompactTrie.h"
+#include "Hypergraph.h"
+#include "Mmcs.h"
+#include "SubsetIndex.h"
+#include "Scheduler.h"
+#include "BorderStream.h"
+#include "Budget.h"
+#include "Snapshot.h"
+
+// -------------------------------------------------
+// algorithms calculating the minimal transversals
+// DUAL_DT : incremental approach of Demetrovics et
+//           Thi, on bit vectors when the items fit
+//           in 512 bits ( BitTransversals ) and on
+//           tries otherwise
+// DUAL_DT_TRIE : same approach always on tries
+//           ( Trie::trMinOpt, Trie::trMinIopt )
+// DUAL_MMCS : enumeration MMCS of Murakami et Uno
+// -------------------------------------------------
+
+enum Dualisation { DUAL_DT, DUAL_DT_TRIE, DUAL_MMCS } ;
+
+
+template< class Item >
+class Zigzag : public Application< Item >
 {
 protected:
+
+	// ---------------------------------------------
+	// attributes and methods of Application used
+	// by this class
+	// ---------------------------------------------
+
+	using Application< Item >::k ;
+	using Application< Item >::trie ;
+	using Application< Item >::minsup ;
+	using Application< Item >::saveFile ;
+	using Application< Item >::fileName ;
+	using Application< Item >::tatree ;
+	using Application< Item >::remap ;
+	using Application< Item >::relist ;
+	using Application< Item >::verbose ;
+	using Application< Item >::bdN ;
+	using Application< Item >::bdP ;
+	using Application< Item >::countCandidates ;
 	
 	// --------------------------------------------------
 	// minimal proportion of non frequents itemsets 
@@ -35,12 +76,199 @@ protected:
 
 	double eps ;
 
+	// --------------------------------------------
+	// algorithm calculating the minimal transversals
+	// --------------------------------------------
+
+	Dualisation dualisation ;
+
+	// ------------------------------------------------
+	// number of threads used by the incremental
+	// calculation of the minimal transversals
+	// ------------------------------------------------
+
+	int nbThreads ;
+
+	// ---------------------------------------------
+	// order of the edges of the negative border
+	// during the incremental calculation
+	// ---------------------------------------------
+
+	EdgeOrder edgeOrder ;
+
+	// ---------------------------------------------
+	// number of complements of the transversals
+	// counted in the db at the same time
+	// ---------------------------------------------
+
+	unsigned int complBatch ;
+
+	// ------------------------------------------------
+	// number of bytes that the transversals may use
+	// during the dualisation ( 0 for no limit ) and
+	// directory of the files where they are kept
+	// beyond it
+	// ------------------------------------------------
+
+	size_t memoryBudget ;
+
+	const char * spillDir ;
+
+	// ------------------------------------------------
+	// prefix of the files where the hypergraphs are
+	// saved before each dualisation ( 0 for none, see
+	// Hypergraph::save ) and number of dualisations
+	// ------------------------------------------------
+
+	const char * dumpPrefix ;
+
+	int nbDumps ;
+
+	string getDumpName() const { return string( dumpPrefix ) + "." + to_string( nbDumps ) + ".hg" ; }
+
+	// ------------------------------------------------
+	// cost model choosing the end of the levelwise
+	// phase and logging the costs of the jumps ( 0 to
+	// keep the rules of apriori on the ratio NFk/Ck )
+	// ------------------------------------------------
+
+	Scheduler * scheduler ;
+
+	// ------------------------------------------------
+	// true if the itemsets of the positive border are
+	// written as soon as they are known to be maximal
+	// instead of at the end of the run, and thread
+	// writing them into the output file
+	// ------------------------------------------------
+
+	bool streaming ;
+
+	BorderStream< Item > stream ;
+
+	// ------------------------------------------------
+	// way the output file is written ( OutputSink )
+	// ------------------------------------------------
+
+	SinkMode outputMode ;
+
+	// ------------------------------------------------
+	// true if the positive border is saved in binary
+	// ( see BorderWriter ) instead of text
+	// ------------------------------------------------
+
+	bool binaryOutput ;
+
+	// ------------------------------------------------
+	// budget of time and memory of the run, checked
+	// after the dualisations, after the pruning of the
+	// candidates and after each level of the optimist
+	// approach
+	// ------------------------------------------------
+
+	Budget budget ;
+
+	// ------------------------------------------------
+	// safe point where the run stopped ( 0 if it
+	// finished ) and numbers of itemsets left there :
+	// negative border not dualised, transversals whose
+	// complements are not counted and itemsets of the
+	// optimist approach whose subsets are not explored
+	// ------------------------------------------------
+
+	const char * stopPoint ;
+
+	unsigned long nbNegLeft ;
+
+	unsigned long nbTrLeft ;
+
+	unsigned long nbOptLeft ;
+
+	// ------------------------------------------------
+	// method that write the state of the run ( see
+	// run ) into the file saveFile.report
+	// ------------------------------------------------
+
+	void saveReport() ;
+
+	// ------------------------------------------------
+	// file where the state of the run is saved every
+	// checkpointSeconds seconds ( 0 for none ), time
+	// of the next snapshot and file of the snapshot
+	// the run is resumed from ( 0 for none )
+	// ------------------------------------------------
+
+	const char * checkpointFile ;
+
+	double checkpointSeconds ;
+
+	double nextCheckpoint ;
+
+	const char * resumeFile ;
+
+	// ------------------------------------------------
+	// positive border of a lower threshold on the same
+	// items ( 0 if unknown ) : the frequent itemsets
+	// are included into its itemsets, so the subsets
+	// of the optimist approach that are not are
+	// infrequent without being counted
+	// ------------------------------------------------
+
+	const SubsetIndex< Item > * bound ;
+
+	// ------------------------------------------------
+	// file where the borders and their supports are
+	// saved at the end of the run ( 0 for none ) and
+	// file of the borders of a previous run on the
+	// beginning of the transactions ( 0 for none )
+	// ------------------------------------------------
+
+	const char * stateFile ;
+
+	const char * updateFile ;
+
+	// ------------------------------------------------
+	// method that write the borders with their
+	// supports into stateFile, the negative border is
+	// calculated from Bd+ if neg is 0
+	// ------------------------------------------------
+
+	bool saveState( Trie< Item > * neg ) ;
+
+	// ------------------------------------------------
+	// method that read the borders of updateFile and
+	// update them with the transactions appended since,
+	// return the size of the smallest itemset that
+	// became frequent ( 0 if none, -1 if the file can't
+	// be used )
+	// ------------------------------------------------
+
+	int updateBorders( vector< unsigned int > * stat ) ;
+
+	// ------------------------------------------------
+	// methods that write the state of the run at the
+	// beginning of an iteration of the dualisations
+	// into checkpointFile and read it from resumeFile,
+	// return false if the file can't be written or
+	// read or if it is not a snapshot of this run
+	// ------------------------------------------------
+
+	bool saveSnapshot( Trie< Item > * transv, Trie< Item > * freqTr, Trie< Item > * opt, vector< unsigned int > * stat ) ;
+
+	bool loadSnapshot( Trie< Item > *& transv, Trie< Item > *& freqTr, Trie< Item > * opt, vector< unsigned int > * stat ) ;
+
 	// --------------------------------------------
 	// set of itemset representing itemsets of the 
 	// positive border found by the initialisation
 	// --------------------------------------------
 
-	Trie * bdPapriori ;
+	Trie< Item > * bdPapriori ;
+
+	// ---------------------------------------------
+	// same set once apriori is finished, it is no
+	// more modified until the final update of bd+
+	// ---------------------------------------------
+
+	CompactTrie< Item > compactBdPapriori ;
 	
 	// ------------------------------
 	// Apriori last level
@@ -63,6 +291,26 @@ protected:
 	// ----------------------------------------------------
 
 	double avgBdP ;
+
+	// ---------------------------------------------------
+	// sub trees of the subsets of a level of the optimist
+	// approach processed by one thread, with their
+	// frequent itemsets and the number of itemsets
+	// deleted wrt Bd+ and of infrequent itemsets
+	// ---------------------------------------------------
+
+	struct OptPart
+	{
+		Trie< Item > trie ;
+
+		vector< pair< vector< Item >, unsigned int > > frequent ;
+
+		unsigned int nbRemoved ;
+
+		unsigned int nbInfrequent ;
+
+		OptPart() : trie( 0 ), nbRemoved( 0 ), nbInfrequent( 0 ) {}
+	};
 	
 	
 	
@@ -96,6 +344,124 @@ public:
 
 	void setEps( double inEps ){ eps = inEps ; }
 
+	// ---------------------------------------------
+	// method initializing the algorithm calculating
+	// the minimal transversals
+	// ---------------------------------------------
+
+	void setDualisation( Dualisation inDual ){ dualisation = inDual ; }
+
+	// ---------------------------------------------
+	// method initializing the number of threads
+	// calculating the minimal transversals
+	// ---------------------------------------------
+
+	void setThreads( int inNbThreads ){ nbThreads = ( inNbThreads > 0 ) ? inNbThreads : 1 ; }
+
+	// ---------------------------------------------
+	// method initializing the order of the edges
+	// ---------------------------------------------
+
+	void setEdgeOrder( EdgeOrder inOrder ){ edgeOrder = inOrder ; }
+
+	// ---------------------------------------------
+	// method initializing the size of the batches
+	// of complements
+	// ---------------------------------------------
+
+	void setComplBatch( unsigned int inBatch ){ complBatch = ( inBatch > 0 ) ? inBatch : 1 ; }
+
+	// ---------------------------------------------
+	// method initializing the memory budget of the
+	// dualisation and the directory of its files
+	// ---------------------------------------------
+
+	void setMemoryBudget( size_t inBudget, const char * inDir ){ memoryBudget = inBudget ; spillDir = inDir ; }
+
+	// ------------------------------------------------
+	// method initializing the prefix of the files of
+	// the hypergraphs dualised ( see benchDual )
+	// ------------------------------------------------
+
+	void setDumpPrefix( const char * inPrefix ){ dumpPrefix = inPrefix ; }
+
+	// ------------------------------------------------
+	// method initializing the cost model of the
+	// levelwise phase and of the jumps
+	// ------------------------------------------------
+
+	void setScheduler( Scheduler * inScheduler ){ scheduler = inScheduler ; }
+
+	// ------------------------------------------------
+	// method choosing to write the positive border
+	// during the run ( see BorderStream )
+	// ------------------------------------------------
+
+	void setStreaming( bool inStreaming ){ streaming = inStreaming ; }
+
+	// ------------------------------------------------
+	// method initializing the way the output file is
+	// written ( write, O_DIRECT or memory mapping )
+	// ------------------------------------------------
+
+	void setOutputMode( SinkMode inMode ){ outputMode = inMode ; }
+
+	// ------------------------------------------------
+	// method choosing the binary format of the
+	// positive border ( see BorderReader.h )
+	// ------------------------------------------------
+
+	void setBinaryOutput( bool inBinary ){ binaryOutput = inBinary ; }
+
+	// ------------------------------------------------
+	// method initializing the budget of wall time and
+	// of resident memory ( 0 for no limit )
+	// ------------------------------------------------
+
+	void setBudget( double inSeconds, size_t inBytes ){ budget.setLimits( inSeconds, inBytes ) ; }
+
+	// ------------------------------------------------
+	// method initializing the file and the period of
+	// the snapshots ( see Snapshot.h )
+	// ------------------------------------------------
+
+	void setCheckpoint( const char * inFile, double inSeconds ){ checkpointFile = inFile ; checkpointSeconds = inSeconds ; }
+
+	// ------------------------------------------------
+	// method initializing the snapshot the run is
+	// resumed from
+	// ------------------------------------------------
+
+	void setResume( const char * inFile ){ resumeFile = inFile ; }
+
+	// ------------------------------------------------
+	// method initializing the positive border of a
+	// lower threshold ( see runSweep in main.cpp )
+	// ------------------------------------------------
+
+	void setBound( const SubsetIndex< Item > * inBound ){ bound = inBound ; }
+
+	// ------------------------------------------------
+	// method initializing the file where the borders
+	// are saved ( see saveState )
+	// ------------------------------------------------
+
+	void setStateFile( const char * inFile ){ stateFile = inFile ; }
+
+	// ------------------------------------------------
+	// method initializing the borders updated with
+	// the appended transactions ( see updateBorders )
+	// ------------------------------------------------
+
+	void setUpdateFile( const char * inFile ){ updateFile = inFile ; }
+
+	// ------------------------------------------------
+	// true if the run stopped before the end ( see
+	// setBudget ), its positive border is partial
+	// ------------------------------------------------
+
+	bool isStopped() const { return stopPoint != 0 ; }
+
 	// ----------------------------------------
 	// method that execute the algrithm zigzag
 	// ----------------------------------------
@@ -111,15 +477,9 @@ public:
 	// stat[0] is total number of itemsets of the trie
 	// -----------------------------------------------
 
-	int processOptBorder(Trie * complSet, set< Trie >  * optIt, Trie * tr,  Trie * freqTr, vector<unsigned int> * stat );
-	
-	bool processOptBorder( set<Trie> *items, vector< short unsigned > *itemset, set< Trie > * optIt,
-		Trie * complSet, Trie * tr,  Trie * freqTr, vector<unsigned int> * stat );
+	int processOptBorder(Trie< Item > * complSet, set< Trie< Item > >  * optIt, Trie< Item > * tr,  Trie< Item > * freqTr, vector<unsigned int> * stat );
 
-	int processOptBorder(Trie * complSet, Trie  * opt, Trie * tr,  Trie * freqTr, vector<unsigned int> * stat );
-	
-	bool processOptBorder( set<Trie> *items, vector< short unsigned > *itemset,Trie * opt,
-		Trie * complSet, Trie * tr,  Trie * freqTr, vector<unsigned int> * stat );
+	int processOptBorder(Trie< Item > * complSet, Trie< Item >  * opt, Trie< Item > * tr,  Trie< Item > * freqTr, vector<unsigned int> * stat );
 
 	// -------------------------------------------------
 	// process the optimist positive border
@@ -131,11 +491,17 @@ public:
 	// stat[0] is total number of itemsets of the trie
 	// -------------------------------------------------
 
-	int processOptGenSub(Trie * complSet, Trie  * opt, Trie * tr, Trie * freqTr,
-							Trie * subSet,  int size, vector<unsigned int> * stat );
-	
-	bool processOptGenSub( set<Trie> *items, vector< short unsigned > *itemset, Trie * opt,
-		Trie * complSet, Trie * tr,  Trie * freqTr ,  Trie * subSet, int size, vector<unsigned int> * stat);
+	int processOptGenSub(Trie< Item > * complSet, Trie< Item >  * opt, Trie< Item > * tr, Trie< Item > * freqTr,
+							Trie< Item > * subSet,  int size, vector<unsigned int> * stat );
+
+	// -------------------------------------------------
+	// same process on the complements of the transversals
+	// of tr, generated and counted by batches of
+	// complBatch itemsets without storing all of them
+	// -------------------------------------------------
+
+	int processComplements( Trie< Item > * tr, Trie< Item > * opt, Trie< Item > * freqTr,
+							Trie< Item > * subSet,  int size, vector<unsigned int> * stat );
 
 	// -----------------------------------------
 	// method that move a transversal that have
@@ -144,7 +510,7 @@ public:
 	// the original set of transversal (tr)
 	// -----------------------------------------
 
-	void moveTransFreq( vector< short unsigned > *itemset, Trie * tr,  Trie * freqTr ) ;
+	void moveTransFreq( vector< Item > *itemset, Trie< Item > * tr,  Trie< Item > * freqTr ) ;
 		
 	//-----------------------------------------
 	// method updating the positive border
@@ -154,6 +520,22 @@ public:
 
 	void updateBdP() ;
 
+	// -----------------------------------------------
+	// method that insert a frequent itemset in the
+	// positive border and update the statistics
+	// -----------------------------------------------
+
+	void updateBdP( vector< Item > *itemset, int supp, vector< unsigned int > * stat ) ;
+
+	// -----------------------------------------------
+	// method that delete from the positive border the
+	// itemsets included into another one, whatever
+	// the approach that found them, and update the
+	// statistics, return the number deleted
+	// -----------------------------------------------
+
+	unsigned int filterBdP( vector< unsigned int > * stat ) ;
+
 	// ----------------------------------------
 	// method processing the optimist approach
 	// ie from a set of itemset in parameter
@@ -163,13 +545,22 @@ public:
 	// until the level lvl
 	// ----------------------------------------
 
-	void optApproach( set< Trie > * optIt, TATREE * tat, int lvl, vector< unsigned int > * stat ) ;
+	unsigned long optApproach( set< Trie< Item > > * optIt, TATREE * tat, int lvl, vector< unsigned int > * stat ) ;
+
+	int optApproach( Trie< Item > * lev, Trie< Item > * nextLev, TATREE * tat, int level, vector< unsigned int > * stat,
+						unsigned int & nbGen, unsigned int & nbCand ) ;
 
-	void optApproach( set< Trie > * items,  vector< short unsigned > * itemset, Trie * nextLev, vector< unsigned int > * stat ) ;
+	unsigned long optApproach( Trie< Item > * opt, TATREE * tat, int lvl, vector< unsigned int > * stat ) ;
 
-	void optApproach( Trie * opt, TATREE * tat, int lvl, vector< unsigned int > * stat ) ;
+	void initOptApproach( Trie< Item > * opt, set< Trie< Item > > * optIt ) ;
 
-	void initOptApproach( set< Trie > * items,  vector< short unsigned > * itemset, set< Trie > * optIt ) ;
+	// ---------------------------------------------------
+	// pruning wrt Bd+ and support update of a part of the
+	// subsets of a level of the optimist approach, the
+	// frequent are moved to the list of the part
+	// ---------------------------------------------------
+
+	void processOptPart( OptPart * part, TATREE * tat, int level ) ;
 
 	// -------------------------------
 	// prune the infrequent itemset 
@@ -179,9 +570,7 @@ public:
 	// (used in the pess approach)
 	// -------------------------------
 
-	int pruneCandidates(Trie * tr, int level);
-
-	int pruneCandidates( int level, set<Trie> *items, int depth, short unsigned *itemset);
+	int pruneCandidates(Trie< Item > * tr, int level);
 
 	// --------------------------------------------------------------
 	// prune the infrequent candidates itemsets, for each infrequent 
@@ -189,10 +578,7 @@ public:
 	// update Bd+ of the pessimist approach
 	// --------------------------------------------------------------
 
-	int processCandTrans(Trie * tr, int level, Trie * transv, int n, int lvl, Trie * freqTr);
-
-	int processCandTrans( int level, set<Trie> *items, int depth, vector< unsigned short> *itemset,
-						  Trie * transv, int n, int lvl, Trie * freqTr);
+	int processCandTrans(Trie< Item > * tr, int level, Trie< Item > * transv, int n, int lvl, Trie< Item > * freqTr);
 
 	// --------------------------------------------------------
 	// prune the frequent itemset without knowing the level
@@ -202,9 +588,7 @@ public:
 	// return the number of frequent found
 	// --------------------------------------------------------
 
-	int pruneCandidatesOpt( Trie * tr, vector< unsigned int > * stat   );
-	
-	int pruneCandidatesOpt( set<Trie> *items, vector< short unsigned > *itemset, vector< unsigned int > * stat  );
+	int pruneCandidatesOpt( Trie< Item > * tr, vector< unsigned int > * stat   );
 		
 	// --------------------------------
 	// method that calcul the distance
@@ -220,9 +604,7 @@ public:
 	// itemset of bd
 	// -----------------------------------------------------------------------
 
-	void pruneCandBottomUp( Trie * tr, Trie * bd, Trie * opt )  ;
-	
-	bool pruneCandBottomUp( set< Trie > * items, Trie * bd, Trie * opt, vector< short unsigned > * vect, Trie * tr ) ;
+	void pruneCandBottomUp( Trie< Item > * tr, Trie< Item > * bd, Trie< Item > * opt )  ;
 
 	// ----------------------------------------------------------------------------------
 	// method that generates the candidates at the level k+1
@@ -231,10 +613,10 @@ public:
 	//  bdp : set of itemsets of bd+ or near bd+ found by jumps
 	// ----------------------------------------------------------------------------------
 
-	void genCand( Trie * subSet, Trie * inbdp ) ;
+	void genCand( Trie< Item > * subSet, Trie< Item > * inbdp ) ;
 
 	
-	bool genCand( Trie * subSet, set<Trie> * childbdp, Trie * tr ) ;
+	bool genCand( Trie< Item > * subSet, set< Trie< Item > > * childbdp, Trie< Item > * tr ) ;
 };
 
 #endif
@@ -54,25 +54,11 @@ static void error (int code, ...)
 
 /*--------------------------------------------------------------------*/
 
-TATREE * apriori( char*fn_in, char*fn_out, int supp, int & level, Trie * bdPapriori, 
-					Trie * bdn , set<Element> * relist , double ratioNfC, double & eps,int ismax,
-                    vector< unsigned int > * stat, int & maxBdP, bool & generatedFk, bool verbose ) 
+int apriori_load( char*fn_in, int supp, set<Element> * relist, bool verbose )
 {
-  int     i, k, n;              /* loop variables, counters */
-  int     tacnt   = 0;          /* number of transactions */
+  int     k, n;                 /* loop variables, counters */
   int     max     = 0;          /* maximum transaction size */
-  int     empty   = 1;          /* number of empty item sets */
-  int     *map, *set;           /* identifier map, item set */
-  char    *usage;               /* flag vector for item usage */
-  clock_t t, tt, tc, x;         /* timer for measurements */
-
-  double actNfC = 1 ;
-  double avgNfC = 0 ;
-  int nbgen = 0 ;
-  int nbfreq = 0 ;
-  level = 1 ;
-  bool endApriori = false ;   // boolean to stop the initial classial apriori approach
-  int bdnsize = 0 ;    // number of itemsets found infrequent
+  clock_t t;                    /* timer for measurements */
 
 	/* --- create item set and transaction set --- */  
   itemset = is_create();        /* create an item set and */
@@ -104,33 +90,131 @@ TATREE * apriori( char*fn_in, char*fn_out, int supp, int & level, Trie * bdPapri
   /* --- sort and recode items --- */
   if( verbose ) MSG(fprintf(stderr, "sorting and recoding items ... "));
   t   = clock();                /* start the timer */
-  map = (int*)malloc(is_cnt(itemset) *sizeof(int));
-  if (!map) error(E_NOMEM);     /* create an item identifier map */
-  n = is_recode(itemset, supp, 2, map);       /* 2: sorting mode */
-  tas_recode(taset, map, n);    /* recode the loaded transactions */
-  max = tas_max(taset);         /* get the new maximal t.a. size */
+  idmap = (int*)malloc(is_cnt(itemset) *sizeof(int));
+  if (!idmap) error(E_NOMEM);   /* create an item identifier map */
+  n = is_recode(itemset, supp, 2, idmap);     /* 2: sorting mode */
+  tas_recode(taset, idmap, n);  /* recode the loaded transactions */
+  itemcnt = n;                  /* note the number of frequent items */
 
   // use in the other part of the implementation to have the corresponding
   // identifiant to an internal id
-  stat->reserve( n+2 ) ;
-  stat->push_back( 0 ) ;
   for(int j= 0; j< n ; j++ )
   {
-    stat->push_back( 0 ) ;
 	relist->insert(  Element( atoi( is_name( itemset, j )  ) ,j) );
   } 
 
   if( verbose ) MSG(fprintf(stderr, "[%d item(s)] ", n));
   if( verbose ) MSG(fprintf(stderr, "done [%.2fs].\n", SEC_SINCE(t)));
 
-  /* --- create a transaction tree --- */
+  return n;
+}  /* apriori_load() */
+
+/*--------------------------------------------------------------------*/
+
+TATREE * apriori_tree( bool verbose )
+{
+  clock_t t;                    /* timer for measurements */
+
   if( verbose ) MSG(fprintf(stderr, "creating transaction tree ... "));
   t = clock();                  /* start the timer */
   tatree = tat_create(taset,1); /* create a transaction tree */
   if (!tatree) error(E_NOMEM);  /* (compactify transactions) */
-  tt = clock() -t;              /* note the construction time */
   if( verbose ) MSG(fprintf(stderr, "done [%.2fs].\n", SEC_SINCE(t)));
 
+  return tatree;
+}  /* apriori_tree() */
+
+/*--------------------------------------------------------------------*/
+
+int apriori_tacnt( void )
+{
+  return tacnt;                 /* number of loaded transactions */
+}  /* apriori_tacnt() */
+
+/*--------------------------------------------------------------------*/
+
+int apriori_support( int item )
+{
+  return is_getfrq(itemset, item); /* support of a recoded item */
+}  /* apriori_support() */
+
+/*--------------------------------------------------------------------*/
+
+TATREE * apriori_delta( int first, bool verbose )
+{
+  TASET   *delta;               /* appended transactions */
+  TATREE  *tree;                /* their transaction tree */
+  int     i;                    /* loop variable */
+  clock_t t;                    /* timer for measurements */
+
+  if( verbose ) MSG(fprintf(stderr, "creating transaction tree of %d appended transaction(s) ... ", tacnt -first));
+  t = clock();                  /* start the timer */
+  delta = tas_create(itemset);  /* create a transaction set */
+  if (!delta) error(E_NOMEM);   /* for the appended transactions */
+  for (i = first; i < tacnt; i++)
+    if (tas_add(delta, tas_tract(taset, i), tas_tsize(taset, i)) != 0)
+      error(E_NOMEM);           /* copy the appended transactions */
+  tree = tat_create(delta, 1);  /* create their transaction tree */
+  if (!tree) error(E_NOMEM);
+  tas_delete(delta, 0);         /* and delete the copies */
+  if( verbose ) MSG(fprintf(stderr, "done [%.2fs].\n", SEC_SINCE(t)));
+
+  return tree;
+}  /* apriori_delta() */
+
+/*--------------------------------------------------------------------*/
+
+void apriori_keep( int keep )
+{
+  keepdata = keep;              /* note the flag for apriori */
+}  /* apriori_keep() */
+
+/*--------------------------------------------------------------------*/
+
+template< class Item >
+TATREE * apriori( char*fn_out, int supp, int & level, Trie< Item > * bdPapriori, 
+					Trie< Item > * bdn , double ratioNfC, double & eps,int ismax,
+                    vector< unsigned int > * stat, int & maxBdP, bool & generatedFk, bool verbose,
+                    Scheduler * scheduler ) 
+{
+  int     i, k, n;              /* loop variables, counters */
+  int     max     = 0;          /* maximum transaction size */
+  int     empty   = 1;          /* number of empty item sets */
+  int     *map, *set;           /* identifier map, item set */
+  char    *usage;               /* flag vector for item usage */
+  clock_t t, tt, tc, x;         /* timer for measurements */
+  clock_t tl;                   /* timer of a level ( scheduler ) */
+
+  double actNfC = 1 ;
+  double avgNfC = 0 ;
+  int nbgen = 0 ;
+  int nbfreq = 0 ;
+  level = 1 ;
+  bool endApriori = false ;   // boolean to stop the initial classial apriori approach
+  int bdnsize = 0 ;    // number of itemsets found infrequent
+
+  n   = itemcnt;                /* get the number of frequent items, */
+  map = idmap;                  /* the identifier map and the */
+  max = tas_max(taset);         /* maximal t.a. size */
+
+  stat->reserve( n+2 ) ;
+  for(int j= 0; j<= n ; j++ )
+    stat->push_back( 0 ) ;
+
+  /* --- create a transaction tree --- */
+  if (keepdata && tatree) {     /* if the tree of a previous run is kept */
+    if( verbose ) MSG(fprintf(stderr, "using the transaction tree\n"));
+    tt = 0;                     /* it is not rebuilt */
+  }
+  else {
+    if( verbose ) MSG(fprintf(stderr, "creating transaction tree ... "));
+    t = clock();                /* start the timer */
+    tatree = tat_create(taset,1); /* create a transaction tree */
+    if (!tatree) error(E_NOMEM);  /* (compactify transactions) */
+    tt = clock() -t;            /* note the construction time */
+    if( verbose ) MSG(fprintf(stderr, "done [%.2fs].\n", SEC_SINCE(t)));
+  }
+
   /* --- create an item set tree --- */
   if( verbose ) MSG(fprintf(stderr, "checking subsets of size 1"));
   t = clock(); tc = 0;          /* start the timer and */
@@ -141,6 +225,7 @@ TATREE * apriori( char*fn_in, char*fn_out, int supp, int & level, Trie * bdPapri
   ist_settac(istree, tacnt);    /* set the number of transactions */
   usage = (char*)malloc(n *sizeof(char));
   if (!usage) error(E_NOMEM);   /* create a item usage vector */
+  if (scheduler) scheduler->start(n);
 
   /* --- check item subsets --- */
   while (ist_height(istree) < max   && ( ( ismax == -1 &&  endApriori == false )
@@ -152,6 +237,8 @@ TATREE * apriori( char*fn_in, char*fn_out, int supp, int & level, Trie * bdPapri
 
 	level ++ ;
 
+	tl = clock() ;
+
 	i = ist_check(istree,usage);/* check current item usage */
 
     if (i < max) max = i;       /* update the maximum set size */
@@ -162,7 +249,7 @@ TATREE * apriori( char*fn_in, char*fn_out, int supp, int & level, Trie * bdPapri
     if (k <  0) error(E_NOMEM); /* add a level to the item set tree */
     if (k != 0) break;          /* if no level was added, abort */
     if( verbose ) MSG(fprintf(stderr, " %d", ist_height(istree)));
-    if ((i < n)                 /* check item usage on current level */
+    if ((i < n) && !keepdata    /* check item usage on current level */
     &&  (i *(double)tt < 0.1 *n *tc)) {
       n = i; x = clock();       /* if items were removed and */
       tas_filter(taset, usage); /* the counting time is long enough, */
@@ -187,7 +274,20 @@ TATREE * apriori( char*fn_in, char*fn_out, int supp, int & level, Trie * bdPapri
     
     bdnsize += nbgen - nbfreq ;
     
-    if( level >=4 && ( bdnsize / nbgen < 1.5 ) && ( bdnsize > 100 ) )
+    if( scheduler && ismax == -1 )
+    {
+        // the cost model chooses between one more pass and the jump
+        // ( unless the last level is given )
+
+        if( ! scheduler->continueLevelwise( level, nbgen, nbfreq, (clock()-tl)/double(CLOCKS_PER_SEC) ) )
+        {
+            if( actNfC < ratioNfC )
+                eps = 0 ;
+
+            endApriori = true ;
+        }
+    }
+    else if( level >=4 && ( bdnsize / nbgen < 1.5 ) && ( bdnsize > 100 ) )
     {        
         if( actNfC < ratioNfC )
         {
@@ -209,7 +309,7 @@ TATREE * apriori( char*fn_in, char*fn_out, int supp, int & level, Trie * bdPapri
   if( verbose ) MSG(fprintf(stderr, "filtering maximal item sets ... "));
 
   if( ratioNfC == 0 || nbgen < k+1 || ist_height(istree)>= max )
-    ist_filter2(istree, IST_MAXFRQ, 0);
+    ist_filter2(istree, IST_MAXFRQ, (Trie< Item > *)0);
   else
     ist_filter2(istree, IST_MAXFRQ, bdn);
   
@@ -253,7 +353,7 @@ TATREE * apriori( char*fn_in, char*fn_out, int supp, int & level, Trie * bdPapri
 		}                           /* print the item set's support */
 		else
 		{
-		   short unsigned * is = new short unsigned[k] ;
+		   Item * is = new Item[k] ;
 			
 		   for (i = 0; i < k; i++)  /* traverse the items */
 		   {
@@ -302,13 +402,26 @@ TATREE * apriori( char*fn_in, char*fn_out, int supp, int & level, Trie * bdPapri
   /* --- clean up --- */
   #ifndef NDEBUG                /* if this is a debug version */
   free(usage);                  /* delete the item usage vector */
-  free(map);                    /* and the identifier map */
   ist_delete(istree);           /* delete the item set tree, */
+  istree = NULL;
 
-  if (taset)  tas_delete(taset, 0);   /* the transaction set, */
-  is_delete(itemset);                 /* and the item set */
+  if (!keepdata) {              /* if the transactions are not kept */
+    free(map);                  /* delete the identifier map, */
+    idmap = NULL;
+    if (taset)  tas_delete(taset, 0); /* the transaction set, */
+    is_delete(itemset);               /* and the item set */
+  }
   #endif
 
   return tatree ;
 
 }
+
+/*--------------------------------------------------------------------*/
+
+template TATREE * apriori( char*, int, int &, Trie< unsigned char > *, Trie< unsigned char > *,
+                           double, double &, int, vector< unsigned int > *, int &, bool &, bool, Scheduler * ) ;
+template TATREE * apriori( char*, int, int &, Trie< short unsigned > *, Trie< short unsigned > *,
+                           double, double &, int, vector< unsigned int > *, int &, bool &, bool, Scheduler * ) ;
+template TATREE * apriori( char*, int, int &, Trie< unsigned int > *, Trie< unsigned int > *,
+                           double, double &, int, vector< unsigned int > *, int &, bool &, bool, Scheduler * ) ;
@@ -34,6 +34,7 @@ using namespace std;
 #include "tract.h"
 #include "istree.h"
 #include "Application.h"
+#include "Scheduler.h"
 
 /*----------------------------------------------------------------------
   Preprocessor Definitions
@@ -98,10 +99,49 @@ static TATREE  *tatree  = NULL; /* transaction tree */
 static ISTREE  *istree  = NULL; /* item set tree */
 static FILE    *in      = NULL; /* input  file */
 static FILE    *out     = NULL; /* output file */
+static int     *idmap   = NULL; /* identifier map */
+static int     tacnt    = 0;    /* number of transactions */
+static int     itemcnt  = 0;    /* number of frequent items */
+static int     keepdata = 0;    /* keep the transactions and the tree */
 
 
-extern "C" TATREE * apriori( char*fn_in, char*fn_out, int supp, int & level,
-							 Trie * bdPapriori, Trie * bdn, set<Element> * relist, double ratioNfC, double & eps, int ismax,
-                             vector< unsigned int > * stat, int & maxBdP, bool & generatedFk, bool verbose  ) ;
+/* read the transactions, recode the frequent items and fill relist */
+/* return the number of frequent items                               */
+
+extern "C" int apriori_load( char*fn_in, int supp, set<Element> * relist, bool verbose ) ;
+
+/* transaction tree of the loaded transactions without the levelwise */
+/* phase ( used to resume a run from a snapshot )                    */
+
+extern "C" TATREE * apriori_tree( bool verbose ) ;
+
+/* number of loaded transactions and support of an item ( internal  */
+/* id ) in them                                                      */
+
+extern "C" int apriori_tacnt( void ) ;
+
+extern "C" int apriori_support( int item ) ;
+
+/* transaction tree of the loaded transactions from number first on  */
+/* ( appended since a previous run ), it must be created before the  */
+/* tree of all the transactions which sorts them                     */
+
+extern "C" TATREE * apriori_delta( int first, bool verbose ) ;
+
+/* the transactions and the transaction tree are kept by apriori to */
+/* mine several thresholds : the first call builds the tree and the  */
+/* others use it, the unused items are not removed from it           */
+
+extern "C" void apriori_keep( int keep ) ;
+
+/* apriori on the loaded transactions ( the items are identified on */
+/* Item in the borders ), the end of the levelwise phase is chosen   */
+/* by scheduler if it is given                                       */
+
+template< class Item >
+TATREE * apriori( char*fn_out, int supp, int & level,
+							 Trie< Item > * bdPapriori, Trie< Item > * bdn, double ratioNfC, double & eps, int ismax,
+                             vector< unsigned int > * stat, int & maxBdP, bool & generatedFk, bool verbose,
+                             Scheduler * scheduler = 0 ) ;
 
 #endif
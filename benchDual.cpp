@@ -0,0 +1,360 @@
+/*----------------------------------------------------------------------
+  File    : benchDual.cpp
+  Contents: benchmark of the calculation of the minimal transversals
+            on the hypergraphs saved during runs ( option -dump of
+            fim_maximal, see Hypergraph::save ). Each dualisation is
+            done with each method ( Demetrovics et Thi with bit
+            vectors or with tries, MMCS ) and the wall time, the peak
+            of allocated memory, the number of transversals after
+            each edge and the equality of the results are reported
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "Hypergraph.h"
+#include "Mmcs.h"
+#include "TrieIterator.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sstream>
+
+// ------------------------------------------------
+// bytes allocated by the global operators new and
+// delete and greatest value since the last reset
+// ( the size of each block is stored before it )
+// ------------------------------------------------
+
+static atomic< long > liveBytes( 0 ) ;
+
+static atomic< long > peakBytes( 0 ) ;
+
+static const size_t HEADER = 16 ;	// keeps the alignment of the blocks
+
+void * operator new( size_t size )
+{
+	char * p = (char *)malloc( size + HEADER ) ;
+
+	long live ;
+
+	long peak ;
+
+	if( p == 0 )
+		throw bad_alloc() ;
+
+	*(size_t *)p = size ;
+
+	live = liveBytes += size ;
+
+	peak = peakBytes ;
+
+	while( ( live > peak ) && ! peakBytes.compare_exchange_weak( peak, live ) ) ;
+
+	return p + HEADER ;
+}
+
+void operator delete( void * p ) noexcept
+{
+	if( p != 0 )
+	{
+		char * block = (char *)p - HEADER ;
+
+		liveBytes -= *(size_t *)block ;
+
+		free( block ) ;
+	}
+}
+
+void operator delete( void * p, size_t ) noexcept
+{
+	operator delete( p ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  methods of dualisation
+*/
+
+enum Method { METHOD_DT, METHOD_TRIE, METHOD_MMCS } ;
+
+static const char * methodNames[] = { "dt", "trie", "mmcs" } ;
+
+// ------------------------------------------
+// parameters given on the command line
+// ------------------------------------------
+
+struct Parameters
+{
+	int threads ;
+	EdgeOrder edgeOrder ;
+	int memory ;
+	char * spillDir ;
+	vector< Method > methods ;
+};
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  true if the two tries store the same itemsets
+*/
+
+template< class Item >
+static bool sameItemsets( Trie< Item > * trie1, Trie< Item > * trie2 )
+{
+	TrieIterator< Item > it1( trie1 ) ;
+
+	TrieIterator< Item > it2( trie2 ) ;
+
+	bool more1, more2 ;
+
+	do
+	{
+		more1 = ( trie1->getChildren() != 0 ) && it1.next() ;
+		more2 = ( trie2->getChildren() != 0 ) && it2.next() ;
+
+		if( more1 && more2 && ( *it1.getItemset() != *it2.getItemset() ) )
+			return false ;
+	}
+	while( more1 && more2 ) ;
+
+	return more1 == more2 ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  dualisation of the hypergraph saved in fileName with
+*  each method, the internal ids of the items are stored
+*  on Item
+*/
+
+template< class Item >
+static int benchFile( const char * fileName, Parameters & param )
+{
+	Hypergraph< Item > edges ;
+
+	Trie< Item > * start = new Trie< Item >( 0 ) ;	// transversals before the edges
+
+	Trie< Item > * freqTr = new Trie< Item >( 0 ) ;
+
+	Trie< Item > * recorded = new Trie< Item >( 0 ) ;	// transversals found by the run
+
+	Trie< Item > * first = 0 ;	// result of the first method
+
+	Trie< Item > * res ;
+
+	Mmcs< Item > * mmcs ;
+
+	int n, k ;
+
+	unsigned int nbRemoved ;
+
+	long base ;
+
+	if( ! edges.load( fileName, n, k, start, freqTr, recorded ) )
+	{
+		cerr << "can't read the hypergraph " << fileName << endl;
+		return 1 ;
+	}
+
+	nbRemoved = edges.minimise() ;
+
+	edges.sort( param.edgeOrder ) ;
+
+	edges.setMemoryBudget( (size_t)param.memory << 20, param.spillDir ) ;
+
+	cout<<fileName<<"\t items : "<<n<<"\t k : "<<k<<"\t edges : "<<edges.getNbEdges()<<" ( "<<nbRemoved<<" non minimal removed )"
+		<<"\t transversals : "<<start->getSupport()<<"\t freqTr : "<<freqTr->getSupport()<<endl;
+
+	for( unsigned int m = 0; m < param.methods.size() ; m++ )
+	{
+		// MMCS enumerates the transversals from scratch,
+		// it can't start from given transversals
+
+		if( ( param.methods[ m ] == METHOD_MMCS ) && ( start->getSupport() != 0 ) )
+		{
+			cout<<"  "<<methodNames[ param.methods[ m ] ]<<"\t skipped ( incremental dualisation )"<<endl;
+			continue ;
+		}
+
+		base = liveBytes ;
+
+		peakBytes = base ;
+
+		auto begin = chrono::steady_clock::now() ;
+
+		if( param.methods[ m ] == METHOD_MMCS )
+		{
+			mmcs = new Mmcs< Item >() ;
+
+			mmcs->addEdges( &edges ) ;
+
+			res = mmcs->trMinOpt( n, k, freqTr ) ;
+
+			delete mmcs ;
+		}
+		else
+		{
+			res = new Trie< Item >( *start ) ;
+
+			edges.setBitsets( param.methods[ m ] == METHOD_DT ) ;
+
+			edges.trMinIopt( res, n, k, freqTr, param.threads ) ;
+		}
+
+		double seconds = chrono::duration< double >( chrono::steady_clock::now() - begin ).count() ;
+
+		cout<<"  "<<methodNames[ param.methods[ m ] ]<<"\t time : "<<seconds<<"s\t peak bytes : "<<peakBytes - base ;
+
+		if( param.methods[ m ] == METHOD_MMCS )
+			cout<<"\t Tr Min max : -\t total : -" ;
+		else
+			cout<<"\t Tr Min max : "<<edges.getMaxSize()<<"\t total : "<<edges.getSumSizes() ;
+
+		cout<<"\t Tr Min : "<<res->getSupport() ;
+
+		if( recorded->getChildren() != 0 )
+			cout<<"\t recorded : "<<( sameItemsets( res, recorded ) ? "same" : "DIFFERENT" ) ;
+
+		if( first != 0 )
+			cout<<"\t "<<methodNames[ param.methods[ 0 ] ]<<" : "<<( sameItemsets( res, first ) ? "same" : "DIFFERENT" ) ;
+
+		cout<<endl;
+
+		if( first == 0 )
+			first = res ;
+		else
+			delete res ;
+	}
+
+	delete first ;
+	delete recorded ;
+	delete freqTr ;
+	delete start ;
+
+	return 0 ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  number of items of the hypergraph saved in fileName
+*  ( first line of the file ), -1 if it can't be read
+*/
+
+static int readNbItems( const char * fileName )
+{
+	ifstream pFile( fileName ) ;
+
+	string line, name ;
+
+	int n = -1 ;
+
+	if( pFile.is_open() && getline( pFile, line ) )
+	{
+		istringstream header( line ) ;
+
+		if( ! ( header >> name >> n ) )
+			n = -1 ;
+	}
+
+	return n ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+int main( int argc, char * argv[] )
+{
+	Parameters param ;
+
+	int nbItems ;
+
+	int res = 0 ;
+
+	int i ;
+
+	param.threads = 1 ;
+	param.edgeOrder = ORDER_LEX ;
+	param.memory = 0 ;
+	param.spillDir = (char *)"." ;
+
+	for( i = 1; ( i < argc ) && ( argv[ i ][ 0 ] == '-' ) ; i++ )
+	{
+		if( strcmp( argv[ i ], "-t" ) == 0 && i + 1 < argc )
+			param.threads = atoi( argv[ ++i ] ) ;
+		else if( strcmp( argv[ i ], "-e" ) == 0 && i + 1 < argc )
+		{
+			i++ ;
+
+			if( strcmp( argv[ i ], "size" ) == 0 )
+				param.edgeOrder = ORDER_SIZE ;
+			else if( strcmp( argv[ i ], "degree" ) == 0 )
+				param.edgeOrder = ORDER_DEGREE ;
+			else
+				param.edgeOrder = ORDER_LEX ;
+		}
+		else if( strcmp( argv[ i ], "-m" ) == 0 && i + 2 < argc )
+		{
+			param.memory = atoi( argv[ ++i ] ) ;
+
+			param.spillDir = argv[ ++i ] ;
+		}
+		else if( strcmp( argv[ i ], "-d" ) == 0 && i + 1 < argc )
+		{
+			// comma separated list of methods
+
+			char * name = strtok( argv[ ++i ], "," ) ;
+
+			for( ; name != 0 ; name = strtok( 0, "," ) )
+			{
+				if( strcmp( name, "dt" ) == 0 )
+					param.methods.push_back( METHOD_DT ) ;
+				else if( strcmp( name, "trie" ) == 0 )
+					param.methods.push_back( METHOD_TRIE ) ;
+				else if( strcmp( name, "mmcs" ) == 0 )
+					param.methods.push_back( METHOD_MMCS ) ;
+				else
+					cerr << "unknown dualisation " << name << endl;
+			}
+		}
+		else
+			cerr << "unknown option " << argv[ i ] << endl;
+	}
+
+	if( i == argc )
+	{
+		cerr << "usage: " << argv[0] << " [-d dt,trie,mmcs] [-t threads] [-e lex|size|degree] [-m megabytes dir] hypergraph..." << endl;
+		return 1 ;
+	}
+
+	if( param.methods.empty() )
+	{
+		param.methods.push_back( METHOD_DT ) ;
+		param.methods.push_back( METHOD_TRIE ) ;
+		param.methods.push_back( METHOD_MMCS ) ;
+	}
+
+	for( ; i < argc ; i++ )
+	{
+		nbItems = readNbItems( argv[ i ] ) ;
+
+		// the smallest type that store the internal ids is used
+
+		if( nbItems < 0 )
+		{
+			cerr << "can't read the hypergraph " << argv[ i ] << endl;
+			res = 1 ;
+		}
+		else if( nbItems < 256 )
+			res |= benchFile< unsigned char >( argv[ i ], param ) ;
+		else if( nbItems < 65536 )
+			res |= benchFile< short unsigned >( argv[ i ], param ) ;
+		else
+			res |= benchFile< unsigned int >( argv[ i ], param ) ;
+	}
+
+	return res ;
+}
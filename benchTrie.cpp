@@ -0,0 +1,256 @@
+/*----------------------------------------------------------------------
+  File    : benchTrie.cpp
+  Contents: benchmark counting the memory allocations done by the
+            tries during the calculation of the minimal transversals
+            ( Demetrovics et Thi approach ) and of their complement
+            on a random hypergraph or on an hypergraph read from a
+            file ( one edge by line, for example a negative border
+            saved during a run )
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "CompactTrie.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <new>
+#include <time.h>
+
+// ------------------------------------------
+// type of the internal identifiers of items
+// ------------------------------------------
+
+typedef short unsigned Item ;
+
+// ------------------------------------------------
+// counters updated by the global operators new and
+// delete ( number of blocks and of bytes )
+// ------------------------------------------------
+
+static unsigned long nbAlloc = 0 ;
+
+static unsigned long nbFree = 0 ;
+
+static unsigned long nbBytes = 0 ;
+
+void * operator new( size_t size )
+{
+	void * p = malloc( size ? size : 1 ) ;
+
+	if( p == 0 )
+		throw bad_alloc() ;
+
+	nbAlloc++ ;
+	nbBytes += size ;
+
+	return p ;
+}
+
+void operator delete( void * p ) noexcept
+{
+	if( p != 0 )
+	{
+		nbFree++ ;
+		free( p ) ;
+	}
+}
+
+void operator delete( void * p, size_t ) noexcept
+{
+	operator delete( p ) ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  print the allocations done since the last call
+*/
+
+static void report( const char * step, clock_t start )
+{
+	static unsigned long lastAlloc = 0, lastFree = 0, lastBytes = 0 ;
+
+	cout<< step <<"\t allocations : "<< nbAlloc - lastAlloc
+		<<"\t frees : "<< nbFree - lastFree
+		<<"\t bytes : "<< nbBytes - lastBytes
+		<<"\t live : "<< nbAlloc - nbFree
+		<<"\t[" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
+
+	lastAlloc = nbAlloc ;
+	lastFree = nbFree ;
+	lastBytes = nbBytes ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+/**
+*  read an hypergraph from a file, each line is an edge
+*  given by the ids of its items, return the number of
+*  items ( greatest id + 1 ) or -1 if the file can't be read
+*/
+
+static int loadHypergraph( const char * fileName, Trie< Item > * hyper )
+{
+	ifstream pFile( fileName ) ;
+
+	string line ;
+
+	vector< Item > edge ;
+
+	unsigned int item ;
+
+	int nbItems = 0 ;
+
+	if( ! pFile.is_open() )
+		return -1 ;
+
+	while( getline( pFile, line ) )
+	{
+		istringstream in( line ) ;
+
+		edge.clear() ;
+
+		while( in >> item )
+		{
+			edge.push_back( item ) ;
+
+			if( (int)item >= nbItems )
+				nbItems = item + 1 ;
+		}
+
+		if( edge.empty() )
+			continue ;
+
+		sort( edge.begin(), edge.end() ) ;
+
+		hyper->insert( &edge ) ;
+	}
+
+	return nbItems ;
+}
+
+// ----------------------------------------------------------------------------------------------
+
+int main( int argc, char * argv[] )
+{
+	int nbItems = 40 ;	// number of items of the hypergraph
+
+	int nbEdges = 200 ;	// number of edges
+
+	int edgeSize = 30 ;	// number of items by edge
+
+	int seed = 1 ;
+
+	Trie< Item > * hyper = new Trie< Item >( 0 ) ;
+
+	clock_t start = clock() ;
+
+	if( ( argc == 2 ) && ! isdigit( argv[ 1 ][ 0 ] ) )
+	{
+		nbItems = loadHypergraph( argv[ 1 ], hyper ) ;
+
+		if( nbItems < 0 )
+		{
+			cerr << "can't read the hypergraph " << argv[ 1 ] << endl;
+			return 1 ;
+		}
+
+		cout<<"hypergraph : "<<argv[ 1 ]<<"\t items : "<<nbItems<<"\t edges : "<<hyper->getSupport()<<endl;
+	}
+	else
+	{
+		if( argc > 1 ) nbItems = atoi( argv[ 1 ] ) ;
+		if( argc > 2 ) nbEdges = atoi( argv[ 2 ] ) ;
+		if( argc > 3 ) edgeSize = atoi( argv[ 3 ] ) ;
+		if( argc > 4 ) seed = atoi( argv[ 4 ] ) ;
+
+		if( nbItems <= 0 || edgeSize <= 0 || edgeSize > nbItems )
+		{
+			cerr << "usage: " << argv[0] << " [items edges edgeSize seed] | [hypergraph file]" << endl;
+			return 1 ;
+		}
+
+		cout<<"items : "<<nbItems<<"\t edges : "<<nbEdges<<"\t edge size : "<<edgeSize<<"\t seed : "<<seed<<endl;
+
+		srand( seed ) ;
+
+		// construction of a random hypergraph
+		// the internal ids of the items are between 0 and nbItems-1
+
+		vector< Item > * edge = new vector< Item >() ;
+
+		vector< bool > used( nbItems ) ;
+
+		for( int e = 0; e < nbEdges; e++ )
+		{
+			edge->clear() ;
+
+			used.assign( nbItems, false ) ;
+
+			while( (int)edge->size() < edgeSize )
+			{
+				int item = rand() % nbItems ;
+
+				if( ! used[ item ] )
+				{
+					used[ item ] = true ;
+					edge->push_back( item ) ;
+				}
+			}
+
+			sort( edge->begin(), edge->end() ) ;
+
+			hyper->insert( edge ) ;
+		}
+
+		delete edge ;
+	}
+
+	report( "hypergraph", start ) ;
+
+	// calculation of the minimal transversals
+
+	start = clock() ;
+
+	Trie< Item > * transv = hyper->trMinOpt( nbItems, 0 ) ;
+
+	report( "transversals", start ) ;
+
+	// complement of the minimal transversals
+
+	start = clock() ;
+
+	Trie< Item > * complSet = transv->complem( nbItems ) ;
+
+	report( "complement", start ) ;
+
+	cout<<"minimal transversals : "<<transv->getSupport()<<"\t complements : "<<complSet->getSupport()<<endl;
+
+	// same set of complements in a compact trie
+
+	start = clock() ;
+
+	CompactTrie< Item > * compact = new CompactTrie< Item >( complSet ) ;
+
+	report( "compact", start ) ;
+
+	cout<<"compact nodes : "<<compact->getNbNodes()<<"\t bytes : "<<compact->memory()<<endl;
+
+	delete compact ;
+
+	// deletion of the tries, the blocks still live
+	// after that are lost
+
+	start = clock() ;
+
+	delete complSet ;
+	delete transv ;
+	delete hyper ;
+
+	report( "deletion", start ) ;
+
+	return 0 ;
+}
@@ -0,0 +1,71 @@
+/*----------------------------------------------------------------------
+  File    : borderText.cpp
+  Contents: convert a positive border saved in binary ( option -bin of
+            fim_maximal, see BorderReader.h ) into the text format of
+            the FIMI workshop : one itemset by line, the names of its
+            items then its support between brackets
+  Author  : Frdric Flouvat
+----------------------------------------------------------------------*/
+
+#include "BorderReader.h"
+#include "OutputSink.h"
+
+#include <iostream>
+
+int main( int argc, char * argv[] )
+{
+	BorderReader reader ;
+
+	OutputSink sink ;
+
+	vector< int > names ;
+
+	if( ( argc < 2 ) || ( argc > 3 ) )
+	{
+		cerr << "usage: " << argv[0] << " border [output]" << endl;
+		return 1 ;
+	}
+
+	if( ! reader.open( argv[ 1 ] ) )
+	{
+		cerr << "can't read the border " << argv[ 1 ] << endl;
+		return 1 ;
+	}
+
+	if( argc == 3 )
+	{
+		if( ! sink.open( argv[ 2 ] ) )
+		{
+			cerr << "can't open the output file " << argv[ 2 ] << endl;
+			return 1 ;
+		}
+	}
+	else
+		sink.attach( 1 ) ;
+
+	// the names of the ids are converted once by the sink
+
+	names = reader.getNames() ;
+
+	sink.setRemap( names.empty() ? 0 : &names[ 0 ] ) ;
+
+	while( reader.next() )
+	{
+		for( unsigned int i = 0; i < reader.getIds().size() ; i++ )
+			sink.putItem( reader.getIds()[ i ] ) ;
+
+		sink.putChar( '(' ) ;
+		sink.putNumber( reader.getSupport() ) ;
+		sink.putText( ")\n" ) ;
+	}
+
+	sink.close() ;
+
+	if( ! sink.good() )
+	{
+		cerr << "can't write the itemsets" << endl;
+		return 1 ;
+	}
+
+	return 0 ;
+}
@@ -530,7 +530,8 @@ void ist_filter (ISTREE *ist, int mode)
   }                             /* that have to be cleared */
 }  /* ist_filter() */
 
-void ist_filter2 (ISTREE *ist, int mode,Trie * bdn)
+template< class Item >
+void ist_filter2 (ISTREE *ist, int mode,Trie< Item > * bdn)
 {                               /* --- filter max. freq. item sets */
   int    i, k, n;               /* loop variables */
   ISNODE *node, *curr;          /* to traverse the nodes */
@@ -538,6 +539,15 @@ void ist_filter2 (ISTREE *ist, int mode,Trie * bdn)
   int    *set;                  /* next (partial) item set to process */
 
   assert(ist);                  /* check the function argument */
+  if (bdn != 0) {               /* the infrequent items ( recoded */
+    node = ist->levels[0];      /* for a lower threshold ) are in */
+    for (i = 0; i < node->size; i++) {  /* the negative border too */
+      if (node->cnts[i] < ist->supp) {
+        Item item = node->offset +i;
+        bdn->insert( &item, 1, node->cnts[i] ) ;
+      }
+    }
+  }
   for (n = 1; n < ist->lvlcnt; n++) {
     for (node = ist->levels[n]; node; node = node->succ) {
       for (i = 0; i < node->size; i++) {
@@ -547,7 +557,7 @@ void ist_filter2 (ISTREE *ist, int mode,Trie * bdn)
 	 
 	  ISNODE * node2 = node ;
 
-	  short unsigned * itemset = new short unsigned[ n+1 ] ; 
+	  Item * itemset = new Item[ n+1 ] ; 
 
 	  int  j = n+1;
 	  itemset[ --j ] = node2->offset +i ;
@@ -579,6 +589,10 @@ void ist_filter2 (ISTREE *ist, int mode,Trie * bdn)
   }                             /* that have to be cleared */
 }  /* ist_filter() */
 
+template void ist_filter2 (ISTREE *ist, int mode, Trie< unsigned char > * bdn);
+template void ist_filter2 (ISTREE *ist, int mode, Trie< short unsigned > * bdn);
+template void ist_filter2 (ISTREE *ist, int mode, Trie< unsigned int > * bdn);
+
 /*--------------------------------------------------------------------*/
 
 void ist_init (ISTREE *ist)
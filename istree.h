@@ -79,7 +79,8 @@ extern int     ist_getcntx (ISTREE *ist, int *sets, int cnt);
 
 extern void    ist_filter  (ISTREE *ist, int mode);
 
-extern void    ist_filter2  (ISTREE *ist, int mode,Trie * bdn);
+template< class Item >
+void           ist_filter2  (ISTREE *ist, int mode,Trie< Item > * bdn);
 
 extern void    ist_init    (ISTREE *ist);
 extern int     ist_set     (ISTREE *ist, int *sets, int *supp);
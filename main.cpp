@@ -5,67 +5,441 @@
 ----------------------------------------------------------------------*/
 
 #include "Zigzag.h"
+#include <algorithm>
 #include <iostream>
 #include <time.h>
 
 
+// -------------------------------------
+// parameters given on the command line
+// -------------------------------------
+
+struct Parameters
+{
+    char * data ;
+    int minsup ;
+    char * saveFile ;
+    int level ;
+    double ratio ;
+    double err ;
+    bool verbose ;
+    Dualisation dualisation ;
+    int threads ;
+    EdgeOrder edgeOrder ;
+    int memory ;
+    char * spillDir ;
+    char * dumpPrefix ;
+    char * scheduleLog ;
+    double dualRate ;
+    double complFactor ;
+    bool stream ;
+    SinkMode output ;
+    bool binary ;
+    double seconds ;
+    int budgetMemory ;
+    char * checkpoint ;
+    double checkpointSeconds ;
+    char * resume ;
+    vector< int > sweep ;
+    char * state ;
+    char * update ;
+};
+
+/**
+*  parameters of a run of ABS except the threshold, the
+*  output file, the scheduler and the snapshots
+*/
+
+template< class Item >
+void setParameters( Zigzag< Item > & a, Parameters & param, set< Element > * relist )
+{
+    a.setLevel( param.level ) ;
+
+   	a.setRatioNfC( param.ratio ) ;
+       	
+   	a.setEps( param.err ) ; 
+
+    if( param.verbose )
+        a.setVerbose(); // print information
+
+    a.setDualisation( param.dualisation ) ;
+
+    a.setThreads( param.threads ) ;
+
+    a.setEdgeOrder( param.edgeOrder ) ;
+
+    a.setMemoryBudget( (size_t)param.memory << 20, param.spillDir ) ;
+
+    a.setDumpPrefix( param.dumpPrefix ) ;
+
+    a.setStreaming( param.stream ) ;
+
+    a.setOutputMode( param.output ) ;
+
+    a.setBinaryOutput( param.binary ) ;
+
+    a.setBudget( param.seconds, (size_t)param.budgetMemory << 20 ) ;
+    
+    a.setData( param.data );
+
+    a.setRelist( relist ) ;
+}
+
+/**
+*  the cost model replaces the rules on NFk/Ck
+*  to choose the end of the levelwise phase
+*/
+
+static void setScheduler( Scheduler & scheduler, Parameters & param )
+{
+    if( ! scheduler.open( param.scheduleLog ) )
+        cerr << "can't open the log " << param.scheduleLog << endl;
+
+    scheduler.setRates( param.dualRate, param.complFactor ) ;
+}
+
+/**
+*  launch ABS with the internal ids of the items stored on Item
+*/
+
+template< class Item >
+int runZigzag( Parameters & param, set< Element > * relist )
+{
+    Zigzag< Item > a;
+
+    Scheduler scheduler ;
+
+    setParameters( a, param, relist ) ;
+
+    if( param.scheduleLog )
+    {
+        setScheduler( scheduler, param ) ;
+
+        a.setScheduler( &scheduler ) ;
+    }
+
+    a.setCheckpoint( param.checkpoint, param.checkpointSeconds ) ;
+
+    a.setResume( param.resume ) ;
+
+    a.setStateFile( param.state ) ;
+
+    a.setUpdateFile( param.update ) ;
+
+    a.setMinSup( param.minsup );	
+    
+    if( param.saveFile )	
+    	a.setSaveFile( param.saveFile ) ;
+
+    return a.run() ;
+}
+
+/**
+*  launch ABS on each threshold of param.sweep, from the lowest
+*  to the highest. The transactions are loaded and recoded once
+*  for the lowest one ( relist ) and the transaction tree built
+*  by the first run is shared by the others. The maximal
+*  itemsets of a threshold include those of the higher ones, so
+*  the positive border of a run bounds the next one ( see
+*  Zigzag::setBound ). The positive border of each threshold is
+*  saved in the file output.minsup
+*/
+
+template< class Item >
+int runSweep( Parameters & param, set< Element > * relist )
+{
+    SubsetIndex< Item > bound ;	// positive border of the last complete run
+
+    bool bounded = false ;
+
+    TATREE * tree = 0 ;
+
+    Scheduler scheduler ;
+
+    string saveFile ;
+
+    int sets = 0 ;
+
+    if( param.scheduleLog )
+        setScheduler( scheduler, param ) ;
+
+    apriori_keep( 1 ) ;
+
+    for( unsigned int t = 0; t < param.sweep.size() ; t++ )
+    {
+        Zigzag< Item > a;
+
+        setParameters( a, param, relist ) ;
+
+        if( param.scheduleLog )
+            a.setScheduler( &scheduler ) ;
+
+        if( bounded )
+            a.setBound( &bound ) ;
+
+        a.setMinSup( param.sweep[ t ] );
+
+        if( param.saveFile )
+        {
+            saveFile = string( param.saveFile ) + "." + to_string( param.sweep[ t ] ) ;
+
+            a.setSaveFile( (char *)saveFile.c_str() ) ;
+        }
+
+        if( param.verbose ) cout << "Sweep : minsup " << param.sweep[ t ] << endl;
+
+        sets += a.run() ;
+
+        // a partial positive border bounds nothing
+
+        if( ! a.isStopped() )
+        {
+            bound.build( a.getBdP() ) ;
+
+            bounded = true ;
+        }
+
+        // the items and the transaction tree are
+        // kept for the next thresholds
+
+        tree = a.getTatree() ;
+
+        a.setTatree( 0 ) ;
+
+        a.setRelist( 0 ) ;
+    }
+
+    apriori_keep( 0 ) ;
+
+    if( tree )
+        tat_delete( tree ) ;
+
+    delete relist ;
+
+    return sets ;
+}
+
 int main(int argc, char *argv[])
 {
 
   if(argc < 3) {
-    cerr << "usage: " << argv[0] << " datafile minsup output" << endl;
+    cerr << "usage: " << argv[0] << " datafile minsup output [-o ratio err] [v] [-d dt|trie|mmcs] [-t threads] [-e lex|size|degree] [-m megabytes dir] [-dump prefix] [-s log] [-sc dualRate complFactor] [-stream] [-io write|direct|mmap] [-bin] [-budget seconds megabytes] [-checkpoint file seconds] [-resume file] [-sweep minsup,minsup...] [-state file] [-update file]" << endl;
    }
   else {
 
-    Zigzag a;
     int sets;
-    
-    double ratio = 0.01;
-    double err = 0.001 ;
-    bool verbose = false;
-    
-    if( argc > 4 && strcmp( argv[ 4 ], "-o") == 0 )
+    int nbItems;
+    Parameters param ;
+
+    param.data = argv[1] ;
+    param.minsup = atoi( argv[2] ) ;
+    param.saveFile = ( argc >= 4 ) ? argv[3] : 0 ;
+    param.level = -1 ;
+    param.ratio = 0.01 ;
+    param.err = 0.001 ;
+    param.verbose = false ;
+    param.dualisation = DUAL_DT ;
+    param.threads = 1 ;
+    param.edgeOrder = ORDER_LEX ;
+    param.memory = 0 ;
+    param.spillDir = (char *)"." ;
+    param.dumpPrefix = 0 ;
+    param.scheduleLog = 0 ;
+    param.dualRate = 0 ;
+    param.complFactor = 0 ;
+    param.stream = false ;
+    param.output = SINK_WRITE ;
+    param.binary = false ;
+    param.seconds = 0 ;
+    param.budgetMemory = 0 ;
+    param.checkpoint = 0 ;
+    param.checkpointSeconds = 0 ;
+    param.resume = 0 ;
+    param.state = 0 ;
+    param.update = 0 ;
+
+    // options after the output file
+
+    for( int i = 4; i < argc ; i++ )
     {
+        if( strcmp( argv[ i ], "-o") == 0 && i + 2 < argc )
+        {
+            param.ratio = atof( argv[ ++i ] ) ;
         
-        ratio = atof( argv[5] ) ;
-        
-        if( ratio > 1)
-                a.setLevel( (int)( ratio) ) ;  
-        else              
-                a.setLevel( -1 );
+            if( param.ratio > 1)
+                param.level = (int)( param.ratio ) ;  
 
-       	err = atof( argv[6] ) ;
-       	
-       	if( argc == 8 && strcmp( argv[ 7 ], "v" ) == 0 )
-       	{
+            param.err = atof( argv[ ++i ] ) ;
+        }
+        else if( strcmp( argv[ i ], "v" ) == 0 )
+            param.verbose = true ;
+        else if( strcmp( argv[ i ], "-d" ) == 0 && i + 1 < argc )
+        {
+            i++ ;
 
-       	     verbose = true ;  	        
-       	     a.setVerbose(); // print information
-      	}          
-    }
-    else
-        a.setLevel( -1 );
+            if( strcmp( argv[ i ], "mmcs" ) == 0 )
+                param.dualisation = DUAL_MMCS ;
+            else if( strcmp( argv[ i ], "dt" ) == 0 )
+                param.dualisation = DUAL_DT ;
+            else if( strcmp( argv[ i ], "trie" ) == 0 )
+                param.dualisation = DUAL_DT_TRIE ;
+            else
+                cerr << "unknown dualisation " << argv[ i ] << endl;
+        }
+        else if( strcmp( argv[ i ], "-t" ) == 0 && i + 1 < argc )
+            param.threads = atoi( argv[ ++i ] ) ;
+        else if( strcmp( argv[ i ], "-e" ) == 0 && i + 1 < argc )
+        {
+            i++ ;
 
+            if( strcmp( argv[ i ], "lex" ) == 0 )
+                param.edgeOrder = ORDER_LEX ;
+            else if( strcmp( argv[ i ], "size" ) == 0 )
+                param.edgeOrder = ORDER_SIZE ;
+            else if( strcmp( argv[ i ], "degree" ) == 0 )
+                param.edgeOrder = ORDER_DEGREE ;
+            else
+                cerr << "unknown edge order " << argv[ i ] << endl;
+        }
+        else if( strcmp( argv[ i ], "-m" ) == 0 && i + 2 < argc )
+        {
+            // memory budget of the transversals and
+            // directory of their files beyond it
 
-   	a.setRatioNfC( ratio ) ;
-       	
-   	a.setEps( err ) ; 
-    
-    a.setData(argv[1]);
+            param.memory = atoi( argv[ ++i ] ) ;
+
+            param.spillDir = argv[ ++i ] ;
+        }
+        else if( strcmp( argv[ i ], "-dump" ) == 0 && i + 1 < argc )
+            param.dumpPrefix = argv[ ++i ] ;
+        else if( strcmp( argv[ i ], "-s" ) == 0 && i + 1 < argc )
+            param.scheduleLog = argv[ ++i ] ;
+        else if( strcmp( argv[ i ], "-sc" ) == 0 && i + 2 < argc )
+        {
+            // coefficients of the cost model ( see the log )
+
+            param.dualRate = atof( argv[ ++i ] ) ;
+
+            param.complFactor = atof( argv[ ++i ] ) ;
+        }
+        else if( strcmp( argv[ i ], "-io" ) == 0 && i + 1 < argc )
+        {
+            i++ ;
+
+            if( strcmp( argv[ i ], "write" ) == 0 )
+                param.output = SINK_WRITE ;
+            else if( strcmp( argv[ i ], "direct" ) == 0 )
+                param.output = SINK_DIRECT ;
+            else if( strcmp( argv[ i ], "mmap" ) == 0 )
+                param.output = SINK_MMAP ;
+            else
+                cerr << "unknown output mode " << argv[ i ] << endl;
+        }
+        else if( strcmp( argv[ i ], "-budget" ) == 0 && i + 2 < argc )
+        {
+            // the run stops at the next safe point once the
+            // wall time or the resident memory is reached
+            // ( 0 for no limit ), see the file output.report
+
+            param.seconds = atof( argv[ ++i ] ) ;
+
+            param.budgetMemory = atoi( argv[ ++i ] ) ;
+        }
+        else if( strcmp( argv[ i ], "-checkpoint" ) == 0 && i + 2 < argc )
+        {
+            // the state of the run is saved in the file
+            // every given seconds ( see -resume )
+
+            param.checkpoint = argv[ ++i ] ;
+
+            param.checkpointSeconds = atof( argv[ ++i ] ) ;
+        }
+        else if( strcmp( argv[ i ], "-resume" ) == 0 && i + 1 < argc )
+            param.resume = argv[ ++i ] ;
+        else if( strcmp( argv[ i ], "-state" ) == 0 && i + 1 < argc )
+            param.state = argv[ ++i ] ;     // borders saved for -update
+        else if( strcmp( argv[ i ], "-update" ) == 0 && i + 1 < argc )
+        {
+            // the borders saved by -state on the beginning of
+            // the dataset are updated with the transactions
+            // appended since
+
+            param.update = argv[ ++i ] ;
+        }
+        else if( strcmp( argv[ i ], "-sweep" ) == 0 && i + 1 < argc )
+        {
+            // comma separated list of thresholds mined
+            // with minsup on the same loaded data
+
+            char * value = strtok( argv[ ++i ], "," ) ;
+
+            for( ; value != 0 ; value = strtok( 0, "," ) )
+                param.sweep.push_back( atoi( value ) ) ;
+        }
+        else if( strcmp( argv[ i ], "-bin" ) == 0 )
+            param.binary = true ;   // bd+ saved in binary ( see borderText )
+        else if( strcmp( argv[ i ], "-stream" ) == 0 )
+            param.stream = true ;   // bd+ written during the run
+        else
+            cerr << "unknown option " << argv[ i ] << endl;
+    }
 
-    a.setMinSup(atoi(argv[2]));	
-    
-    if( argc >= 4 )	
-    	a.setSaveFile( argv[3] ) ;
-		    
     clock_t start = clock();
 
-    sets = a.run() ;
+    // loading of the transactions and recoding of the frequent items
+
+    set< Element > * relist = new set< Element > ;
+
+    if( ! param.sweep.empty() )
+    {
+        // the items are recoded for the lowest threshold
+
+        param.sweep.push_back( param.minsup ) ;
+
+        sort( param.sweep.begin(), param.sweep.end() ) ;
 
-    if( verbose ) cout << sets << "\t[" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
+        param.sweep.erase( unique( param.sweep.begin(), param.sweep.end() ), param.sweep.end() ) ;
+
+        param.minsup = param.sweep[ 0 ] ;
+
+        if( param.checkpoint || param.resume )
+            cerr << "no snapshot during a sweep" << endl;
+
+        if( param.state || param.update )
+            cerr << "no update of the borders during a sweep" << endl;
+    }
+    else if( param.state )
+    {
+        // the negative border is counted at the end of
+        // the run, the unused items must stay in the tree
+
+        apriori_keep( 1 ) ;
+    }
+
+    nbItems = apriori_load( param.data, param.minsup, relist, param.verbose ) ;
+
+    // the internal ids are between 0 and nbItems ( nbItems is used
+    // by the complement ) so the smallest type that store them is used
+
+    if( ! param.sweep.empty() )
+    {
+        if( nbItems < 256 )
+            sets = runSweep< unsigned char >( param, relist ) ;
+        else if( nbItems < 65536 )
+            sets = runSweep< short unsigned >( param, relist ) ;
+        else
+            sets = runSweep< unsigned int >( param, relist ) ;
+    }
+    else if( nbItems < 256 )
+        sets = runZigzag< unsigned char >( param, relist ) ;
+    else if( nbItems < 65536 )
+        sets = runZigzag< short unsigned >( param, relist ) ;
+    else
+        sets = runZigzag< unsigned int >( param, relist ) ;
+
+    if( param.verbose ) cout << sets << "\t[" << (clock()-start)/double(CLOCKS_PER_SEC) << "s]" << endl;
 
   }
 
   return 0;
 }
-